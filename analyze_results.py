@@ -15,19 +15,41 @@ def read_results(csv_file):
     try:
         with open(csv_file, 'r') as f:
             reader = csv.DictReader(f)
-            for row in reader:
+            required = {'instance', 'p', 'q', 'algorithm', 'alpha', 'executionTime', 'bestSolution'}
+            missing = required - set(reader.fieldnames or [])
+            if missing:
+                print(f"Erro: {csv_file} não tem as colunas {', '.join(sorted(missing))}!")
+                sys.exit(1)
+            for line, row in enumerate(reader, start=2):
+                # Linha com mais ou menos colunas que o cabeçalho
+                if None in row or None in row.values():
+                    print(f"Erro: a linha {line} de {csv_file} não tem as colunas do cabeçalho!")
+                    sys.exit(1)
                 results.append(row)
         return results
     except FileNotFoundError:
         print(f"Erro: Arquivo {csv_file} não encontrado!")
         sys.exit(1)
 
+def instance_key(row):
+    """Instância e par (p,q): o limite inferior e o ótimo dependem dos dois"""
+    return f"{row['instance']} (p={row['p']}, q={row['q']})"
+
+def lower_bounds(results):
+    """Maior limite inferior registrado por instância (colunas vazias são ignoradas)"""
+    bounds = {}
+    for row in results:
+        if row.get('lowerBound', ''):
+            key = instance_key(row)
+            bounds[key] = max(bounds.get(key, 0), int(row['lowerBound']))
+    return bounds
+
 def organize_by_algorithm(results):
     """Organiza resultados por algoritmo e instância"""
     data = defaultdict(lambda: defaultdict(list))
     
     for row in results:
-        instance = row['instance']
+        instance = instance_key(row)
         algorithm = row['algorithm']
         if algorithm == 'randomized':
             algorithm = f"randomized_alpha_{row['alpha']}"
@@ -71,7 +93,7 @@ def calculate_average_times(results):
     times = defaultdict(lambda: defaultdict(list))
     
     for row in results:
-        instance = row['instance']
+        instance = instance_key(row)
         algorithm = row['algorithm']
         if algorithm == 'randomized':
             algorithm = f"randomized_alpha_{row['alpha']}"
@@ -186,8 +208,15 @@ def main():
     # TODO: Preencher com os valores da literatura para cada instância
     best_known = {}
     # Exemplo:
-    # best_known['instances/grafo1.col'] = 10
-    # best_known['instances/grafo2.col'] = 15
+    # best_known['instances/grafo1.col (p=2, q=1)'] = 10
+    # best_known['instances/grafo2.col (p=2, q=1)'] = 15
+    
+    # Sem valor da literatura, o desvio é medido contra o limite inferior do
+    # CSV (coluna lowerBound): é um limite superior para o desvio do ótimo
+    bounds = lower_bounds(results)
+    for instance, bound in bounds.items():
+        if instance not in best_known and bound > 0:
+            best_known[instance] = bound
     
     # Calcula desvios
     deviations = calculate_deviations(data, best_known)
@@ -229,7 +258,8 @@ def main():
     
     print("\n" + "=" * 60)
     print("IMPORTANTE: Ajuste os valores de 'best_known' no script")
-    print("com as melhores soluções conhecidas da literatura!")
+    print("com as melhores soluções conhecidas da literatura! Sem eles, os")
+    print("desvios são medidos contra o limite inferior (coluna lowerBound).")
     print("=" * 60)
 
 if __name__ == "__main__":
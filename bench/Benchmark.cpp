@@ -0,0 +1,317 @@
+// Suíte de benchmarks das etapas internas e dos solvers (make bench).
+// Cada benchmark roda uma repetição de aquecimento e N repetições medidas;
+// são informados mediana, p95 e vazão (operações por segundo na mediana).
+// O resultado também é gravado em JSON para comparar versões.
+//
+// Uso: bin/lpqbench [-trials N] [-sizes 1000,5000] [-degree D] [-p P] [-q Q]
+//                   [-json arquivo] [instâncias .col...]
+
+#include "../include/Graph.h"
+#include "../include/LPQColoring.h"
+#include "../include/ConstructionWorkspace.h"
+#include "../include/Generator.h"
+#include "../include/NeighborScan.h"
+#include "../include/ThreadPool.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Um benchmark medido sobre um grafo
+struct BenchResult {
+    std::string graph;
+    int vertices;
+    long long edges;
+    std::string name;
+    int trials;
+    double median;      // Segundos
+    double p95;         // Segundos
+    double operations;  // Operações por repetição
+    std::string unit;
+    double throughput;  // operations / median
+};
+
+struct BenchConfig {
+    int trials;
+    std::vector<int> sizes;
+    double degree;
+    int p;
+    int q;
+    int maxPlainVertices;  // buildSolution (não incremental) só até este tamanho
+    std::string jsonFile;
+    std::vector<std::string> instances;
+
+    BenchConfig() : trials(7), sizes({1000, 5000}), degree(16.0), p(2), q(1),
+                    maxPlainVertices(2000), jsonFile("results/bench.json") {}
+};
+
+class Benchmark {
+private:
+    const BenchConfig& config;
+    std::vector<BenchResult> results;
+    volatile long long checksum;  // Mantém vivos os resultados das chamadas medidas
+
+    // Executa func uma vez para aquecimento e config.trials vezes medindo
+    template<typename Func>
+    void measure(const std::string& graphName, Graph* graph, const std::string& name,
+                 double operations, const std::string& unit, Func func) {
+        func();
+        std::vector<double> times;
+        for (auto t = 0; t < config.trials; t++) {
+            times.push_back(Utils::measureExecutionTime(func));
+        }
+        std::sort(times.begin(), times.end());
+
+        BenchResult result;
+        result.graph = graphName;
+        result.vertices = graph->getNumVertices();
+        result.edges = countEdges(graph);
+        result.name = name;
+        result.trials = config.trials;
+        result.median = times[times.size() / 2];
+        result.p95 = times[static_cast<std::size_t>(std::ceil(0.95 * times.size())) - 1];
+        result.operations = operations;
+        result.unit = unit;
+        result.throughput = result.median > 0 ? operations / result.median : 0.0;
+        results.push_back(result);
+
+        std::cout << "  " << std::left << std::setw(28) << name << std::right
+                  << std::fixed << std::setprecision(6) << std::setw(12) << result.median << " s"
+                  << std::setw(12) << result.p95 << " s" << std::setprecision(1)
+                  << std::setw(14) << result.throughput << " " << unit << "/s" << std::endl;
+    }
+
+    static long long countEdges(Graph* graph) {
+        long long degreeSum = 0;
+        for (auto v = 0; v < graph->getNumVertices(); v++) degreeSum += graph->getDegree(v);
+        return degreeSum / 2;
+    }
+
+    static std::string jsonEscape(const std::string& text) {
+        std::string escaped;
+        for (auto c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+public:
+    explicit Benchmark(const BenchConfig& benchConfig) : config(benchConfig), checksum(0) {}
+
+    // Leitura do arquivo DIMACS (parser + CSR + distância 2)
+    void benchLoad(const std::string& instance, Graph* graph) {
+        measure(instance, graph, "load", 1, "graphs", [&]() {
+            std::cout.setstate(std::ios::failbit);  // Silencia as mensagens de leitura
+            delete Graph::readFromFile(instance);
+            std::cout.clear();
+        });
+    }
+
+    // Etapas internas e solvers sobre um grafo já carregado
+    void benchGraph(const std::string& graphName, Graph* graph) {
+        auto n = graph->getNumVertices();
+
+        std::cout << "\n" << graphName << " (" << n << " vértices, " << countEdges(graph)
+                  << " arestas)" << std::endl;
+        std::cout << "  " << std::left << std::setw(28) << "benchmark" << std::right
+                  << std::setw(14) << "mediana" << std::setw(14) << "p95"
+                  << std::setw(18) << "vazão" << std::endl;
+
+        if (!graph->isDistance2Implicit()) {
+            measure(graphName, graph, "computeDistance2Neighbors", n, "vertices", [&]() {
+                graph->computeDistance2Neighbors(1, 0, Distance2Mode::Explicit);
+            });
+        }
+
+        LPQColoring solver(graph, config.p, config.q, 1);
+        auto reference = solver.greedy();
+
+        // Menor cor válida de cada vértice, com os demais coloridos (caminho da
+        // busca local, do path relinking e do reparo)
+        auto coloring = reference.coloring;
+        ForbiddenColors scratch;
+        long long sink = 0;
+        measure(graphName, graph, "smallestValidColorBelow", n, "vertices", [&]() {
+            for (auto v = 0; v < n; v++) {
+                auto color = coloring[v];
+                coloring[v] = -1;
+                sink += solver.smallestValidColorBelow(v, reference.maxColor + 1, coloring, scratch);
+                coloring[v] = color;
+            }
+        });
+
+        // Mapa de cores proibidas com metade dos vértices coloridos em ordem
+        // aleatória (propagado por assignColor, como nas construções)
+        std::mt19937 rng(1);
+        std::vector<int> order(n);
+        for (auto v = 0; v < n; v++) order[v] = v;
+        std::shuffle(order.begin(), order.end(), rng);
+        Solution partial(n);
+        ForbiddenColors forbidden;
+        forbidden.reset(n);
+        for (auto i = 0; i < n / 2; i++) {
+            solver.assignColor(order[i], forbidden.smallestAllowed(order[i]), partial, forbidden);
+        }
+        measure(graphName, graph, "smallestAllowed", n - n / 2, "vertices", [&]() {
+            for (auto i = n / 2; i < n; i++) {
+                sink += forbidden.smallestAllowed(order[i]);
+            }
+        });
+        measure(graphName, graph, "calculateVertexCost", n - n / 2, "vertices", [&]() {
+            for (auto i = n / 2; i < n; i++) {
+                sink += solver.calculateVertexCost(order[i], partial.coloring, forbidden);
+            }
+        });
+
+        // Construções com o workspace reaproveitado entre repetições, como nos laços GRASP
+        ConstructionWorkspace workspace(n);
+        if (n <= config.maxPlainVertices) {
+            measure(graphName, graph, "buildSolution", 1, "constructions", [&]() {
+                solver.buildSolution(0.3, rng, workspace);
+                sink += workspace.solution.maxColor;
+            });
+        } else {
+            std::cout << "  " << std::left << std::setw(28) << "buildSolution" << std::right
+                      << "  (ignorado: mais de " << config.maxPlainVertices << " vértices)" << std::endl;
+        }
+        measure(graphName, graph, "buildSolutionIncremental", 1, "constructions", [&]() {
+            solver.buildSolutionIncremental(0.3, rng, workspace);
+            sink += workspace.solution.maxColor;
+        });
+
+        // Uma construção já usa a menor cor válida em cada vértice e não tem o
+        // que melhorar; com as cores dobradas (ainda válida, pois as diferenças
+        // também dobram) a busca local tem classes altas a esvaziar
+        solver.buildSolutionIncremental(0.3, rng, workspace);
+        auto spread = workspace.solution;
+        for (auto& color : spread.coloring) color *= 2;
+        spread.maxColor *= 2;
+        Solution searched;
+        measure(graphName, graph, "localSearch", 1, "calls", [&]() {
+            searched = spread;
+            solver.localSearch(searched, 100, workspace);
+            sink += searched.maxColor;
+        });
+
+        measure(graphName, graph, "isSolutionValid", n, "vertices", [&]() {
+            sink += solver.isSolutionValid(reference) ? 1 : 0;
+        });
+
+        // Solvers completos (1 thread)
+        measure(graphName, graph, "greedy", 1, "runs", [&]() {
+            sink += solver.greedy().maxColor;
+        });
+        measure(graphName, graph, "dsatur", 1, "runs", [&]() {
+            sink += solver.dsatur().maxColor;
+        });
+        measure(graphName, graph, "reactive-10", 10, "constructions", [&]() {
+            sink += solver.greedyRandomizedReactive({0.1, 0.3, 0.5}, 10, 5).maxColor;
+        });
+
+        checksum += sink;
+    }
+
+    bool saveJSON() const {
+        std::ofstream file(config.jsonFile);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao criar arquivo JSON: " << config.jsonFile << std::endl;
+            return false;
+        }
+
+        file << "{\n"
+             << "  \"datetime\": \"" << Utils::getCurrentDateTime() << "\",\n"
+             << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n"
+             << "  \"hardwareThreads\": " << ThreadPool::hardwareThreads() << ",\n"
+             << "  \"neighborScan\": \"" << NeighborScan::name(NeighborScan::bestSupported()) << "\",\n"
+             << "  \"p\": " << config.p << ",\n"
+             << "  \"q\": " << config.q << ",\n"
+             << "  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const auto& r = results[i];
+            file << "    {\"graph\": \"" << jsonEscape(r.graph) << "\", \"vertices\": " << r.vertices
+                 << ", \"edges\": " << r.edges << ", \"benchmark\": \"" << jsonEscape(r.name)
+                 << "\", \"trials\": " << r.trials << std::setprecision(9)
+                 << ", \"median\": " << r.median << ", \"p95\": " << r.p95
+                 << ", \"operations\": " << r.operations << ", \"unit\": \"" << r.unit
+                 << "\", \"throughput\": " << r.throughput << "}"
+                 << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-trials") == 0 && i + 1 < argc) {
+            config.trials = std::max(1, std::stoi(argv[++i]));
+        } else if (strcmp(argv[i], "-sizes") == 0 && i + 1 < argc) {
+            config.sizes.clear();
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                if (!item.empty()) config.sizes.push_back(std::stoi(item));
+            }
+        } else if (strcmp(argv[i], "-degree") == 0 && i + 1 < argc) {
+            config.degree = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            config.p = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+            config.q = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-json") == 0 && i + 1 < argc) {
+            config.jsonFile = argv[++i];
+        } else if (argv[i][0] != '-') {
+            config.instances.push_back(argv[i]);
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "=== Benchmarks L(p,q) (p = " << config.p << ", q = " << config.q << ", "
+              << config.trials << " repetições) ===" << std::endl;
+
+    Benchmark bench(config);
+
+    for (const auto& instance : config.instances) {
+        std::cout.setstate(std::ios::failbit);
+        Graph* graph = Graph::readFromFile(instance);
+        std::cout.clear();
+        if (graph == nullptr) continue;
+
+        bench.benchGraph(instance, graph);
+        bench.benchLoad(instance, graph);
+        delete graph;
+    }
+
+    for (auto size : config.sizes) {
+        std::ostringstream degree;
+        degree << config.degree;
+
+        Graph* random = Generator::random(size, config.degree, 1);
+        if (random != nullptr) {
+            bench.benchGraph("random-" + std::to_string(size) + "-d" + degree.str(), random);
+            delete random;
+        }
+
+        Graph* geometric = Generator::geometric(size, config.degree, 1);
+        if (geometric != nullptr) {
+            bench.benchGraph("geometric-" + std::to_string(size) + "-d" + degree.str(), geometric);
+            delete geometric;
+        }
+    }
+
+    if (!bench.saveJSON()) return 1;
+    std::cout << "\nResultados gravados em: " << config.jsonFile << std::endl;
+    return 0;
+}
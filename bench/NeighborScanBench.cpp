@@ -0,0 +1,106 @@
+// Microbenchmark da varredura de vizinhos (NeighborScan): compara as
+// implementações escalar, SSE4.1 e AVX2 sobre as listas de distância 1 e 2
+// de uma instância, com uma coloração válida (varredura completa, como na
+// validação) e com cores de teste aleatórias (parada antecipada).
+//
+// Uso: bin/neighbor_scan_bench [instância] [p] [q] [repetições]
+
+#include "../include/Graph.h"
+#include "../include/LPQColoring.h"
+#include "../include/NeighborScan.h"
+#include "../include/Utils.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Soma os índices retornados para que o compilador não descarte as varreduras
+long long scanAll(Graph* graph, NeighborScan::Isa isa, const std::vector<int>& coloring,
+                  const std::vector<int>& probeColors, int p, int q) {
+    long long checksum = 0;
+    auto n = graph->getNumVertices();
+    for (auto v = 0; v < n; v++) {
+        auto color = probeColors.empty() ? coloring[v] : probeColors[v];
+        auto neighbors = graph->getNeighbors(v);
+        auto neighbors2 = graph->getDistance2Neighbors(v);
+        // Limite 1 usa a varredura de igualdade, como em ConstraintKernels
+        checksum += p == 1 ? NeighborScan::firstEqual(isa, neighbors.data(), neighbors.size(), coloring.data(), color)
+                           : NeighborScan::firstWithin(isa, neighbors.data(), neighbors.size(),
+                                                       coloring.data(), color, p);
+        checksum += q == 1 ? NeighborScan::firstEqual(isa, neighbors2.data(), neighbors2.size(), coloring.data(), color)
+                           : NeighborScan::firstWithin(isa, neighbors2.data(), neighbors2.size(),
+                                                       coloring.data(), color, q);
+    }
+    return checksum;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string instance = argc > 1 ? argv[1] : "instances/r250.5.col";
+    int p = argc > 2 ? std::stoi(argv[2]) : 2;
+    int q = argc > 3 ? std::stoi(argv[3]) : 1;
+    int repetitions = argc > 4 ? std::stoi(argv[4]) : 2000;
+    
+    GraphOptions options;
+    options.distance2Mode = Distance2Mode::Explicit;
+    Graph* graph = Graph::readFromFile(instance, options);
+    if (graph == nullptr) return 1;
+    
+    LPQColoring solver(graph, p, q, 1);
+    auto solution = solver.greedy();
+    
+    auto n = graph->getNumVertices();
+    std::size_t scanned = 0;
+    for (auto v = 0; v < n; v++) {
+        scanned += graph->getNeighbors(v).size() + graph->getDistance2Neighbors(v).size();
+    }
+    
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> colorDist(0, solution.maxColor);
+    std::vector<int> probeColors(n);
+    for (auto& color : probeColors) color = colorDist(rng);
+    
+    std::vector<NeighborScan::Isa> isas = {NeighborScan::Isa::Scalar};
+    auto best = NeighborScan::bestSupported();
+    if (best != NeighborScan::Isa::Scalar) isas.push_back(NeighborScan::Isa::SSE4);
+    if (best == NeighborScan::Isa::AVX2) isas.push_back(NeighborScan::Isa::AVX2);
+    
+    std::cout << "\nInstância: " << instance << " (p = " << p << ", q = " << q << ", "
+              << scanned << " entradas de vizinhança, " << repetitions << " repetições)" << std::endl;
+    std::cout << "Implementação escolhida em tempo de execução: " << NeighborScan::name(best) << std::endl;
+    
+    const char* scenarios[2] = {"validação (sem conflito)", "cores aleatórias"};
+    for (auto scenario = 0; scenario < 2; scenario++) {
+        std::cout << "\n" << scenarios[scenario] << ":" << std::endl;
+        const std::vector<int> noProbe;
+        const auto& probes = scenario == 0 ? noProbe : probeColors;
+        
+        double scalarTime = 0.0;
+        long long reference = 0;
+        for (auto isa : isas) {
+            long long checksum = 0;
+            auto seconds = Utils::measureExecutionTime([&]() {
+                for (auto r = 0; r < repetitions; r++) {
+                    checksum += scanAll(graph, isa, solution.coloring, probes, p, q);
+                }
+            });
+            if (isa == NeighborScan::Isa::Scalar) {
+                scalarTime = seconds;
+                reference = checksum;
+            }
+            
+            std::cout << "  " << std::setw(8) << NeighborScan::name(isa) << ": "
+                      << std::fixed << std::setprecision(4) << seconds << " s, "
+                      << std::setprecision(3) << seconds * 1e9 / (static_cast<double>(scanned) * repetitions)
+                      << " ns/entrada, speedup " << std::setprecision(2) << scalarTime / seconds
+                      << (checksum == reference ? "" : " (RESULTADO DIVERGENTE)") << std::endl;
+        }
+    }
+    
+    delete graph;
+    return 0;
+}
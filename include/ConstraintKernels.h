@@ -0,0 +1,37 @@
+#ifndef CONSTRAINTKERNELS_H
+#define CONSTRAINTKERNELS_H
+
+#include "Graph.h"
+#include "ForbiddenColors.h"
+#include <vector>
+
+// Operações sobre as restrições L(p,q) que percorrem a vizinhança de um
+// vértice. Há versões com p e q fixados em tempo de compilação para os pares
+// mais usados ((2,1), (1,1) e (3,2)), em que as comparações de diferença viram
+// constantes, e uma versão genérica que usa os valores recebidos. Com limite 1
+// (|a - b| < 1 é apenas a == b), isValidColor usa a varredura de igualdade
+// (NeighborScan::firstEqual) e forbidAround proíbe uma única cor; nos demais
+// limites a varredura vetorizada recebe o limite como argumento. A escolha é feita uma única vez
+// (select) e os argumentos p e q são ignorados pelas versões especializadas.
+struct ConstraintKernels {
+    // true se color não conflita com nenhum vizinho já colorido
+    bool (*isValidColor)(const Graph& graph, int p, int q, int vertex, int color,
+                         const std::vector<int>& coloring);
+    
+    // Proíbe, nos vizinhos ainda não coloridos, as cores que conflitam com
+    // color; retorna quantos vizinhos foram atualizados
+    int (*forbidAround)(const Graph& graph, int p, int q, int vertex, int color,
+                         const std::vector<int>& coloring, ForbiddenColors& forbidden);
+    
+    // Menor cor válida abaixo de limit (limit se não houver); scratch é usado
+    // como mapa de cores proibidas de uma linha
+    int (*smallestValidColorBelow)(const Graph& graph, int p, int q, int vertex, int limit,
+                                   const std::vector<int>& coloring, ForbiddenColors& scratch);
+    
+    const char* name;  // Ex.: "(2,1)" ou "genérico"
+    
+    // Núcleos para o par (p, q)
+    static const ConstraintKernels& select(int p, int q);
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef CONSTRUCTIONWORKSPACE_H
+#define CONSTRUCTIONWORKSPACE_H
+
+#include "LPQColoring.h"
+#include "ForbiddenColors.h"
+#include "CostBuckets.h"
+#include <vector>
+#include <utility>
+
+// Estado temporário das construções GRASP e da busca local, dimensionado uma
+// vez por grafo e reaproveitado entre iterações (um por thread). Depois das
+// primeiras iterações (quando os buffers e o intervalo de custos da fila
+// chegam ao tamanho de trabalho) o laço não aloca: os buffers só são limpos,
+// e a melhor solução é guardada trocando buffers com solution em vez de copiá-la.
+class ConstructionWorkspace {
+public:
+    Solution solution;  // Solução em construção; a busca local opera sobre ela
+
+    // Construção
+    ForbiddenColors forbidden;
+    CostBuckets queue;                        // Vazia ao final de cada construção
+    std::vector<int> saturation;              // Zerado vértice a vértice ao colorir
+    std::vector<int> uncolored;               // buildSolution (não incremental)
+    std::vector<std::pair<int, int>> costs;   // buildSolution (não incremental)
+
+    // Busca local
+    std::vector<int> colorCount;
+    std::vector<std::vector<int>> colorClasses;
+    std::vector<int> classPosition;
+    std::vector<int> worklist;
+    ForbiddenColors scratch;
+
+    // Path relinking (colorCount também é usado como histograma do caminho)
+    Solution relinkBest;              // Melhor solução intermediária do caminho
+    std::vector<int> differences;     // Vértices com cores diferentes na origem e no guia
+    std::vector<int> displaced;       // Vizinhos que perderam a cor no passo atual
+
+    ConstructionWorkspace() {}
+    explicit ConstructionWorkspace(int n) { reset(n); }
+
+    // Prepara uma nova construção sobre n vértices. Na primeira chamada (ou se n
+    // mudar) dimensiona tudo; nas seguintes só limpa o que a anterior usou.
+    void reset(int n);
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef COSTBUCKETS_H
+#define COSTBUCKETS_H
+
+#include <vector>
+#include <random>
+
+// Fila de prioridade indexada por vértice com custos inteiros.
+// Os vértices são agrupados em baldes por custo, num vetor indexado por
+// custo - base; cada vértice guarda sua posição no balde. Uma árvore de
+// Fenwick sobre os tamanhos dos baldes dá as contagens acumuladas, então
+// inserção, remoção, atualização, countUpTo e selectUpTo custam O(log B),
+// onde B é a largura do intervalo de custos. Baldes vazios continuam no
+// vetor com sua capacidade, então, depois que o intervalo de custos e os
+// baldes atingem o tamanho de trabalho, as operações não alocam.
+class CostBuckets {
+private:
+    std::vector<std::vector<int>> buckets;  // buckets[custo - base]: vértices
+    int base;                               // Custo do balde 0
+    int lowest;                             // Menor e maior índice de balde não vazio
+    int highest;                            // (válidos apenas se count > 0)
+    std::vector<int> tree;                  // Fenwick (base 1) dos tamanhos dos baldes
+    std::vector<int> costOf;                // Custo atual de cada vértice
+    std::vector<int> position;              // Posição no balde (-1 se ausente)
+    int count;
+    
+    // Amplia o vetor de baldes para incluir cost (com folga, realoca raramente)
+    void ensureRange(int cost);
+    
+    // Fenwick: soma delta ao balde index; vértices nos baldes 0..index; menor
+    // balde cujo acumulado passa de rank (rank-ésimo vértice em ordem de custo)
+    void addToTree(int index, int delta);
+    int prefixCount(int index) const;
+    int findRank(int rank) const;
+    
+    void detach(int vertex);
+
+public:
+    CostBuckets();
+    
+    // Esvazia a estrutura para n vértices
+    void reset(int n);
+    
+    // Esvazia a estrutura mantendo n; custa só os vértices ainda presentes
+    void clear();
+    
+    int capacity() const { return static_cast<int>(position.size()); }
+    
+    // Insere o vértice ou atualiza seu custo
+    void update(int vertex, int cost);
+    
+    void remove(int vertex);
+    
+    bool contains(int vertex) const { return position[vertex] != -1; }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    
+    int minCost() const { return base + lowest; }
+    int maxCost() const { return base + highest; }
+    
+    // Número de vértices com custo <= threshold (tamanho da RCL)
+    int countUpTo(double threshold) const;
+    
+    // Sorteia uniformemente um vértice com custo <= threshold
+    int selectUpTo(double threshold, std::mt19937& rng) const;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef ELITEPOOL_H
+#define ELITEPOOL_H
+
+#include "LPQColoring.h"
+#include <cstddef>
+#include <vector>
+
+// Conjunto das melhores soluções distintas encontradas (pool elite do path
+// relinking). A diversidade é a distância de Hamming entre colorações (número
+// de vértices com cores diferentes): uma solução só entra se diferir de todos
+// os membros em pelo menos minDistance vértices, a menos que seja a melhor.
+// Com o pool cheio, substitui o membro mais parecido entre os que não são
+// melhores que ela.
+class ElitePool {
+private:
+    std::size_t capacity;
+    int minDistance;
+    std::vector<Solution> members;
+    std::vector<int> memberIters;  // Iteração que encontrou cada membro (desempates)
+
+public:
+    ElitePool(std::size_t capacity, int minDistance);
+
+    // Vértices com cores diferentes em a e b
+    static int distance(const Solution& a, const Solution& b);
+
+    // Tenta inserir sol (copiada); retorna true se entrou no pool
+    bool offer(const Solution& sol, int iteration);
+
+    // Oferece todos os membros de other, em ordem
+    void merge(const ElitePool& other);
+
+    std::size_t size() const { return members.size(); }
+    const Solution& operator[](std::size_t i) const { return members[i]; }
+    int iteration(std::size_t i) const { return memberIters[i]; }
+
+    // Índice do membro de menor maxColor (empate: menor iteração)
+    std::size_t best() const;
+};
+
+#endif
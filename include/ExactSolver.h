@@ -0,0 +1,60 @@
+#ifndef EXACTSOLVER_H
+#define EXACTSOLVER_H
+
+#include "Graph.h"
+#include "LPQColoring.h"
+#include "SearchControl.h"
+#include "Instrumentation.h"
+#include <vector>
+#include <algorithm>
+
+// Solver exato (branch-and-bound) para instâncias pequenas e médias.
+// Aperta o span a partir de uma solução válida: para k = maxColor-1, decide
+// por backtracking se existe coloração com cores 0..k; se existir, ela vira a
+// incumbente e k diminui; se a busca terminar sem solução, a incumbente é
+// ótima. O limite inferior encerra o aperto sem busca.
+//
+// A busca ramifica como o DSATUR (vértice de menor domínio, empate pelo maior
+// grau em G e G²; cores em ordem crescente) sobre domínios em bitset, com
+// verificação adiante: atribuir uma cor retira dos domínios dos vizinhos não
+// coloridos as cores em conflito, e um domínio vazio poda o ramo. A simetria
+// c -> k - c é quebrada restringindo o primeiro vértice a cores <= k/2.
+//
+// Com várias threads, a árvore é dividida em subproblemas (prefixos de
+// atribuições) mantidos em filas por thread: cada thread consome a própria
+// fila e, vazia, rouba de outra. Enquanto houver threads ociosas, quem está
+// buscando doa as alternativas ainda não tentadas do seu nível mais raso.
+class ExactSolver {
+private:
+    Graph* graph;
+    int p;
+    int q;
+    int numThreads;
+    SearchControl* control;            // Tempo limite global e histórico (opcional)
+    int lowerBound;                    // Limite inferior conhecido (0 se não informado)
+    Instrumentation* instrumentation;  // Contadores da execução (opcional)
+
+    int provenBound;                   // Limite inferior comprovado pela última chamada
+    long long nodes;                   // Nós explorados na última chamada
+
+    // Decide se há coloração com cores 0..k; se houver, grava em found
+    bool searchSpan(int k, Solution& found, bool& interrupted);
+
+public:
+    ExactSolver(Graph* g, int p_val, int q_val);
+
+    void setNumThreads(int threads) { numThreads = std::max(1, threads); }
+    void setSearchControl(SearchControl* searchControl) { control = searchControl; }
+    void setLowerBound(int bound) { lowerBound = std::max(0, bound); }
+    void setInstrumentation(Instrumentation* stats) { instrumentation = stats; }
+
+    // Melhor solução a partir da solução válida initial (ótima, a menos que o
+    // tempo acabe antes)
+    Solution solve(const Solution& initial);
+
+    // Limite inferior ao final de solve: igual ao span da solução se ela é ótima
+    int getLowerBound() const { return provenBound; }
+    long long getNodes() const { return nodes; }
+};
+
+#endif
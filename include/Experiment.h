@@ -0,0 +1,91 @@
+#ifndef EXPERIMENT_H
+#define EXPERIMENT_H
+
+#include "Graph.h"
+#include "LPQColoring.h"
+#include "Utils.h"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <utility>
+
+// Uma execução de algoritmo (uma linha do CSV)
+struct ExperimentConfig {
+    std::string algorithm;
+    int p;
+    int q;
+    double alpha;                 // randomized
+    std::vector<double> alphas;   // reactive
+    int iterations;
+    int blockSize;
+    int eliteSize;                // Pool elite do path relinking no reactive (0 = desativado)
+    std::string initial;          // Solução inicial de randomized/reactive: "none" | "dsatur"
+    unsigned int seed;
+    int threads;                  // Threads do solver (iterações GRASP)
+    std::string improvement;      // Fase de melhoria após o algoritmo: "none" | "tabu"
+    long long tabuIterations;     // Orçamento de iterações da busca tabu (0 = sem limite)
+    double tabuTimeLimit;         // Orçamento de tempo da busca tabu em segundos (0 = sem limite)
+    std::size_t tabuMemoryLimit;  // Bytes das tabelas da busca tabu (0 = sem limite)
+    double timeLimit;             // Tempo limite de toda a execução em segundos (0 = sem limite)
+    std::string traceFile;        // Histórico de melhorias em CSV (vazio = não grava)
+    bool earlyStop;               // Para ao atingir o limite inferior
+    int lowerBound;               // Limite inferior já calculado (-1 = calcular em run)
+    
+    ExperimentConfig() : p(0), q(0), alpha(0.3), alphas({0.1, 0.3, 0.5}), iterations(0),
+                         blockSize(30), eliteSize(0), initial("none"), seed(0), threads(1), improvement("none"),
+                         tabuIterations(100000), tabuTimeLimit(0.0), tabuMemoryLimit(std::size_t(1024) << 20),
+                         timeLimit(0.0),
+                         earlyStop(true), lowerBound(-1) {}
+};
+
+// Plano de experimentos em lote: produto cartesiano de instâncias, pares (p,q),
+// algoritmos, alphas (randomized) e sementes
+struct ExperimentPlan {
+    std::vector<std::string> instances;
+    std::vector<std::pair<int, int>> pqPairs;
+    std::vector<std::string> algorithms;
+    std::vector<double> alphas;
+    std::vector<unsigned int> seeds;
+    std::vector<std::string> improvements;
+    long long tabuIterations;
+    double tabuTimeLimit;
+    std::size_t tabuMemoryLimit;
+    double timeLimit;
+    bool earlyStop;
+    int iterationsRandomized;
+    int iterationsReactive;
+    int blockSize;
+    int eliteSize;
+    std::string initial;
+    std::string csvFile;
+    
+    ExperimentPlan() : alphas({0.1, 0.3, 0.5}), improvements({"none"}), tabuIterations(100000),
+                       tabuTimeLimit(0.0), tabuMemoryLimit(std::size_t(1024) << 20), timeLimit(0.0), earlyStop(true), iterationsRandomized(30), iterationsReactive(300),
+                       blockSize(30), eliteSize(0), initial("none"), csvFile("results/results.csv") {}
+};
+
+class Experiment {
+public:
+    static bool isKnownAlgorithm(const std::string& algorithm);
+    static bool isKnownImprovement(const std::string& improvement);
+    static bool isKnownInitial(const std::string& initial);
+    
+    // Executa uma configuração sobre um grafo já carregado, valida a solução
+    // e monta o registro de resultado. A solução é devolvida na numeração
+    // original dos vértices, mesmo que o grafo tenha sido renumerado. O tempo
+    // limite conta a partir de start, se informado (ex.: chegada da requisição
+    // no serviço), ou do início do algoritmo.
+    static ExecutionResult run(Graph* graph, const std::string& instance,
+                               const ExperimentConfig& config, Solution& solution, bool& valid,
+                               const std::chrono::steady_clock::time_point* start = nullptr);
+    
+    // Lê um arquivo de plano (ver README); retorna false em caso de erro
+    static bool readPlan(const std::string& filename, ExperimentPlan& plan);
+    
+    // Carrega cada instância uma única vez, executa toda a grade de
+    // configurações em um pool de workers e grava o CSV de uma só vez
+    static int runPlan(const ExperimentPlan& plan, int workers, const GraphOptions& graphOptions);
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FORBIDDENCOLORS_H
+#define FORBIDDENCOLORS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Mapa de bits de cores proibidas por vértice.
+// Cada vértice possui uma linha de palavras de 64 bits; o bit c indica que a
+// cor c viola alguma restrição com um vizinho já colorido. A menor cor válida
+// passa a ser uma busca pelo primeiro bit zero.
+class ForbiddenColors {
+private:
+    int numVertices;
+    std::size_t wordsPerVertex;
+    std::size_t usedWords;  // Palavras de cada linha escritas desde a última limpeza
+    std::vector<uint64_t> bits;
+    
+    // Aumenta a capacidade de cores de todas as linhas (dobrando)
+    void grow(int color);
+
+public:
+    ForbiddenColors();
+    
+    // Limpa o mapa para n vértices
+    void reset(int n);
+    
+    // Limpa o mapa mantendo n e a capacidade de cores; só as palavras já
+    // usadas de cada linha são zeradas
+    void clear();
+    
+    // Proíbe as cores [lo, hi] para o vértice (lo é limitado a 0); retorna
+    // quantas delas ainda não estavam proibidas
+    int forbidRange(int vertex, int lo, int hi);
+    
+    // Proíbe uma única cor (intervalo de largura 1, caso p = 1 ou q = 1);
+    // retorna 1 se ela ainda não estava proibida
+    int forbidColor(int vertex, int color) {
+        if (static_cast<std::size_t>(color) >= wordsPerVertex * 64) grow(color);
+        auto word = static_cast<std::size_t>(color >> 6);
+        if (word >= usedWords) usedWords = word + 1;
+        auto& bitsWord = bits[static_cast<std::size_t>(vertex) * wordsPerVertex + word];
+        auto mask = 1ULL << (color & 63);
+        auto added = (bitsWord & mask) == 0 ? 1 : 0;
+        bitsWord |= mask;
+        return added;
+    }
+    
+    bool isForbidden(int vertex, int color) const;
+    
+    // Menor cor não proibida para o vértice
+    int smallestAllowed(int vertex) const { return smallestAllowedFrom(vertex, 0); }
+    
+    // Menor cor não proibida >= from
+    int smallestAllowedFrom(int vertex, int from) const;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "Graph.h"
+#include <functional>
+#include <memory>
+#include <string>
+
+// Famílias de grafos do gerador em fluxo (bin/lpqgen)
+enum class GraphFamily {
+    Random,     // Erdős–Rényi G(n, p) com p = avgDegree / (n - 1)
+    Geometric,  // Disco unitário: pontos no quadrado unitário a distância < raio
+    Grid,       // Grade quadrada (4 vizinhos) com ⌈√n⌉ colunas
+    Hexagonal,  // Grade hexagonal celular (6 vizinhos), linhas ímpares deslocadas
+    PowerLaw    // Chung–Lu com graus esperados em lei de potência
+};
+
+// Arestas geradas sob demanda: apenas O(n) de estado (coordenadas ou pesos)
+// fica em memória, nunca a lista de arestas. Cada aresta sai uma vez como
+// (u, v), u < v, em ordem lexicográfica; assim cada lista de adjacência é
+// preenchida já ordenada ao gravar o CSR.
+class EdgeStream {
+public:
+    virtual ~EdgeStream() {}
+    
+    virtual int numVertices() const = 0;
+    
+    // Chama emit(u, v) para cada aresta. Chamadas repetidas geram as mesmas
+    // arestas (a semente é reaplicada), o que permite contar antes de gravar.
+    virtual void forEachEdge(const std::function<void(int, int)>& emit) const = 0;
+};
+
+// Geradores de grafos sintéticos (benchmarks e testes de escala). Os grafos
+// saem finalizados com as opções informadas; mesma semente, mesmo grafo.
+class Generator {
+public:
+    // Erdős–Rényi G(n, m) com m = n * avgDegree / 2 arestas sorteadas
+    static Graph* random(int n, double avgDegree, unsigned int seed,
+                         const GraphOptions& options = GraphOptions());
+    
+    // Grafo geométrico aleatório no quadrado unitário: pontos a distância
+    // menor que o raio que resulta no grau médio pedido são ligados
+    static Graph* geometric(int n, double avgDegree, unsigned int seed,
+                            const GraphOptions& options = GraphOptions());
+    
+    // Fluxo de arestas da família pedida. avgDegree não se aplica às grades;
+    // exponent é o expoente da lei de potência (> 2). nullptr se inválido.
+    static std::unique_ptr<EdgeStream> stream(GraphFamily family, int n, double avgDegree,
+                                              unsigned int seed, double exponent = 2.5);
+    
+    // random | geometric | grid | hex | powerlaw
+    static bool parseFamily(const std::string& name, GraphFamily& family);
+    static const char* familyName(GraphFamily family);
+    
+    // Grava o grafo em DIMACS sem guardar as arestas. O total de arestas,
+    // desconhecido no início, é escrito no fim sobre um campo reservado da
+    // linha "p". Retorna o número de arestas ou -1 em erro.
+    static long long writeDimacs(const EdgeStream& edges, const std::string& filename,
+                                 const std::string& comment = "");
+};
+
+#endif
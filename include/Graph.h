@@ -3,30 +3,319 @@
 
 #include <vector>
 #include <string>
-#include <set>
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include "Instrumentation.h"
+
+// Intervalo contíguo (somente leitura) sobre um dos arrays CSR do grafo
+class NeighborRange {
+private:
+    const int* first;
+    const int* last;
+
+public:
+    NeighborRange() : first(nullptr), last(nullptr) {}
+    NeighborRange(const int* b, const int* e) : first(b), last(e) {}
+    
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    const int* data() const { return first; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](std::size_t i) const { return first[i]; }
+};
+
+// Forma de representar a vizinhança a distância 2
+enum class Distance2Mode {
+    Auto,      // Materializa se couber no limite de memória, senão usa o modo implícito
+    Explicit,  // Sempre materializa as listas (falha se exceder o limite)
+    Implicit   // Percorre vizinhos de vizinhos no momento da consulta
+};
+
+// Renumeração dos vértices após a leitura, para que vizinhos tenham IDs
+// próximos e os acessos coloring[vizinho] fiquem em poucas linhas de cache
+enum class VertexOrder {
+    None,    // Mantém a ordem do arquivo
+    RCM,     // Reverse Cuthill-McKee (minimiza a banda da matriz de adjacência)
+    BFS,     // Ordem de descoberta de uma busca em largura por componente
+    Degree   // Grau decrescente
+};
+
+// Opções de carregamento/pré-processamento do grafo
+struct GraphOptions {
+    int numThreads;                    // Threads para construir a vizinhança a distância 2
+    std::size_t distance2MemoryLimit;  // Limite em bytes para as listas de distância 2 (0 = sem limite)
+    Distance2Mode distance2Mode;
+    VertexOrder vertexOrder;
+    std::string cacheFile;             // Cache binário do grafo (vazio = não usa)
+    
+    GraphOptions() : numThreads(1), distance2MemoryLimit(std::size_t(2048) << 20),
+                     distance2Mode(Distance2Mode::Auto), vertexOrder(VertexOrder::None) {}
+};
+
+// Marcas por época usadas para deduplicar a travessia implícita da distância 2.
+// Cada thread possui a sua; uma nova época invalida todas as marcas em O(1).
+struct VisitStamps {
+    std::vector<unsigned int> stamp;
+    unsigned int epoch;
+    
+    VisitStamps() : epoch(0) {}
+    
+    // Inicia uma nova travessia sobre n vértices
+    void begin(int n) {
+        if (stamp.size() < static_cast<std::size_t>(n)) stamp.resize(n, 0);
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+    bool visited(int v) const { return stamp[v] == epoch; }
+    void visit(int v) { stamp[v] = epoch; }
+    
+    // Marcas da thread atual
+    static VisitStamps& local();
+};
+
+// Listas de adjacência com folga, usadas depois que o grafo finalizado sofre
+// alterações. Cada lista tem início, fim e limite próprios; a que cresce além
+// do limite é realocada no fim de indices e o trecho antigo vira lixo até a
+// próxima compactação.
+struct DynamicLists {
+    std::vector<std::size_t> starts;
+    std::vector<std::size_t> ends;
+    std::vector<std::size_t> limits;
+    std::vector<int> indices;
+    std::size_t live;  // Entradas em uso
+    
+    DynamicLists() : live(0) {}
+    
+    // Copia as n listas de um CSR (offsets com n+1 entradas)
+    void assign(const std::size_t* offsets, const int* data, int n);
+    
+    // Substitui a lista v (values não pode apontar para indices)
+    void store(int v, const int* values, std::size_t count);
+    
+    // Acrescenta uma lista vazia
+    void addList();
+    
+    // Regrava as listas em sequência, descartando folga e lixo
+    void compact();
+};
+
+// Alteração de topologia (ver Graph::applyChange e LPQColoring::repair)
+enum class ChangeType {
+    AddEdge,      // Aresta (u, v)
+    RemoveEdge,   // Aresta (u, v)
+    AddVertex,    // Novo vértice isolado, com o próximo ID
+    RemoveVertex  // Remove as arestas de u (o ID continua existindo, isolado)
+};
+
+struct GraphChange {
+    ChangeType type;
+    int u;
+    int v;
+    
+    GraphChange(ChangeType t, int a = -1, int b = -1) : type(t), u(a), v(b) {}
+};
+
+class MappedFile;
+class EdgeStream;
 
 class Graph {
+    friend class Benchmark;  // bench/Benchmark.cpp mede a construção da distância 2
+    
 private:
     int numVertices;
-    std::vector<std::vector<int>> adjList;  // Lista de adjacência
-    std::vector<std::set<int>> distance2Neighbors;  // Vizinhos a distância 2
     
-    void computeDistance2Neighbors();
+    // Arestas lidas do arquivo (usadas apenas até a construção do CSR)
+    std::vector<std::pair<int, int>> pendingEdges;
+    
+    // Representação CSR (compressed sparse row):
+    // vizinhos de v ficam em indices[offsets[v] .. offsets[v+1])
+    std::vector<std::size_t> adjOffsets;
+    std::vector<int> adjIndices;
+    std::vector<std::size_t> d2Offsets;   // Vizinhos a distância 2
+    std::vector<int> d2Indices;
+    
+    // Arrays em uso: apontam para os vetores acima, para o cache mapeado ou,
+    // no grafo dinâmico, para as listas com folga. O fim da lista de v é
+    // *EndsData[v] (no CSR estático, o início da lista seguinte).
+    const std::size_t* adjOffsetsData;
+    const std::size_t* adjEndsData;
+    const int* adjIndicesData;
+    const std::size_t* d2OffsetsData;
+    const std::size_t* d2EndsData;
+    const int* d2IndicesData;
+    std::unique_ptr<MappedFile> cacheMapping;
+    
+    // Modo implícito: apenas o número de vizinhos a distância 2 é armazenado
+    bool implicitDistance2;
+    std::vector<int> d2Degrees;
+    
+    // Renumeração: originalIds[v] = índice (0-based) de v no arquivo.
+    // Vazio quando os vértices mantêm a ordem original.
+    VertexOrder vertexOrder;
+    std::vector<int> originalIds;
+    
+    // Tempos de leitura e da distância 2 (com LPQ_INSTRUMENT)
+    Instrumentation loadStats;
+    
+    // Alterações depois de finalize(): na primeira, os CSR (próprios ou
+    // mapeados) são copiados para listas com folga e liberados
+    bool finalized;
+    bool dynamic;
+    DynamicLists adjLists;
+    DynamicLists d2Lists;
+    
+    void bindOwnedArrays();
+    void bindDistance2Arrays();
+    void bindEnds();
+    void bindDynamicArrays();
+    void makeDynamic();
+    
+    // Regrava a lista de adjacência de v (grafo dinâmico)
+    void storeNeighbors(int v, const std::vector<int>& neighbors);
+    
+    // Atualiza a distância 2 após inserir/remover a aresta (u, v): u e v são
+    // recalculados e cada vizinho w de um extremo ganha ou perde o outro
+    // extremo conforme reste um vizinho comum, em O(grau·(grau + |d2|))
+    void updateDistance2Around(int u, int v, bool inserted);
+    
+    // Recalcula a vizinhança a distância 2 (lista ou, no modo implícito, grau) de v
+    void refreshDistance2(int v);
+    
+    // Inclui ou remove x da vizinhança a distância 2 de w
+    void setDistance2(int w, int x, bool present);
+    
+    // Ordena e remove duplicatas das arestas pendentes, gerando o CSR de distância 1
+    void buildAdjacencyCSR();
+    
+    // Calcula a ordem pedida e renumera o CSR de distância 1 (antes da distância 2)
+    void reorderVertices(VertexOrder order);
+    std::vector<int> computeOrder(VertexOrder order) const;
+    
+    // Constrói o CSR de distância 2 em paralelo. Se exceder o limite de memória,
+    // passa ao modo implícito (quando permitido) ou falha.
+    bool computeDistance2Neighbors(int numThreads, std::size_t memoryLimit, Distance2Mode mode);
+
+    // Cache binário: CSR de distância 1 e, se materializadas, listas de distância 2.
+    // Com sourceFile vazio, lê um grafo binário avulso (sem arquivo de origem).
+    static Graph* loadCache(const std::string& cacheFile, const std::string& sourceFile,
+                            const GraphOptions& options);
+    bool saveCache(const std::string& cacheFile, const std::string& sourceFile) const;
 
 public:
     Graph(int n);
+    ~Graph();
+    
+    // Antes de finalize(), acumula a aresta para o CSR. Depois, insere-a no
+    // grafo e atualiza a distância 2 apenas em torno dela. Retorna false para
+    // laços, vértices inválidos ou aresta já existente.
+    bool addEdge(int u, int v);
+    
+    // Alterações incrementais no grafo finalizado (custo proporcional à
+    // vizinhança dos vértices envolvidos, não ao tamanho do grafo). Não podem
+    // ocorrer durante a execução de um solver sobre o grafo.
+    bool removeEdge(int u, int v);
+    int addVertex();             // Retorna o ID do novo vértice
+    bool removeVertex(int v);    // Remove todas as arestas de v
+    bool applyChange(const GraphChange& change);
+    
+    bool hasEdge(int u, int v) const;
+    
+    // true se a e b têm um vizinho comum diferente de except
+    bool hasCommonNeighbor(int a, int b, int except) const;
+    
+    // Constrói os arrays CSR (distância 1 e 2) a partir das arestas adicionadas.
+    // Retorna false se as listas de distância 2 excederem o limite de memória.
+    bool finalize(const GraphOptions& options = GraphOptions());
     
-    void addEdge(int u, int v);
     int getNumVertices() const;
-    const std::vector<int>& getNeighbors(int v) const;
-    const std::set<int>& getDistance2Neighbors(int v) const;
+    NeighborRange getNeighbors(int v) const {
+        return NeighborRange(adjIndicesData + adjOffsetsData[v], adjIndicesData + adjEndsData[v]);
+    }
+    
+    // Listas materializadas de distância 2 (apenas quando !isDistance2Implicit())
+    NeighborRange getDistance2Neighbors(int v) const {
+        return NeighborRange(d2IndicesData + d2OffsetsData[v], d2IndicesData + d2EndsData[v]);
+    }
+    
+    bool isDistance2Implicit() const { return implicitDistance2; }
+    int getDistance2Degree(int v) const;
+    
+    // Retorna true assim que pred(w) for verdadeiro para algum vizinho w a
+    // distância 2 de v. Funciona nos dois modos; no implícito percorre os
+    // vizinhos de vizinhos com as marcas da thread (não pode ser aninhado).
+    template<typename Pred>
+    bool anyDistance2Neighbor(int v, Pred pred) const;
+    
+    // Chama func(w) para cada vizinho w a distância 2 de v
+    template<typename Func>
+    void forEachDistance2Neighbor(int v, Func func) const;
+    
+    // Renumeração aplicada na leitura (ver GraphOptions::vertexOrder)
+    bool isReordered() const { return !originalIds.empty(); }
+    VertexOrder getVertexOrder() const { return vertexOrder; }
+    int getOriginalId(int v) const { return originalIds.empty() ? v : originalIds[v]; }
+    
+    // Converte um vetor indexado pelos vértices internos (ex.: coloring) para
+    // a numeração original do arquivo
+    std::vector<int> toOriginalOrder(const std::vector<int>& values) const;
+    
+    const Instrumentation& getLoadStats() const { return loadStats; }
     
     // Métodos auxiliares
     int getDegree(int v) const;
     void printGraph() const;
     
-    // Leitura de arquivo
-    static Graph* readFromFile(const std::string& filename);
+    // Leitura de arquivo DIMACS (mapeado em memória). Com options.cacheFile,
+    // reaproveita o cache binário quando ele corresponde ao arquivo de origem
+    // e o cria/atualiza caso contrário. Arquivos no formato binário (cache ou
+    // writeBinary) são reconhecidos pelo cabeçalho e mapeados diretamente.
+    static Graph* readFromFile(const std::string& filename, const GraphOptions& options = GraphOptions());
+    
+    // Grava o CSR de distância 1 no formato binário sem guardar as arestas:
+    // uma passada conta os graus e as listas são gravadas em faixas de
+    // vértices que cabem em memoryLimit bytes, uma passada por faixa.
+    // Retorna o número de arestas ou -1 em erro.
+    static long long writeBinary(const EdgeStream& edges, const std::string& filename,
+                                 std::size_t memoryLimit = std::size_t(1024) << 20);
 };
 
+template<typename Pred>
+bool Graph::anyDistance2Neighbor(int v, Pred pred) const {
+    if (!implicitDistance2) {
+        for (int neighbor2 : getDistance2Neighbors(v)) {
+            if (pred(neighbor2)) return true;
+        }
+        return false;
+    }
+    
+    VisitStamps& stamps = VisitStamps::local();
+    stamps.begin(numVertices);
+    stamps.visit(v);
+    for (int neighbor : getNeighbors(v)) {
+        stamps.visit(neighbor);
+    }
+    for (int neighbor : getNeighbors(v)) {
+        for (int neighbor2 : getNeighbors(neighbor)) {
+            if (!stamps.visited(neighbor2)) {
+                stamps.visit(neighbor2);
+                if (pred(neighbor2)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+template<typename Func>
+void Graph::forEachDistance2Neighbor(int v, Func func) const {
+    anyDistance2Neighbor(v, [&func](int neighbor2) {
+        func(neighbor2);
+        return false;
+    });
+}
+
 #endif
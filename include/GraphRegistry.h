@@ -0,0 +1,75 @@
+#ifndef GRAPHREGISTRY_H
+#define GRAPHREGISTRY_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// Grafo mantido em memória pelo registro. Compartilhado entre as requisições
+// em andamento: continua válido mesmo depois de removido do registro.
+class RegisteredGraph {
+private:
+    std::mutex boundsMutex;
+    std::map<std::pair<int, int>, int> lowerBounds;  // Limite inferior por (p, q)
+
+public:
+    std::unique_ptr<Graph> graph;
+    std::string instance;
+    uint64_t contentHash;
+    double loadTime;  // Segundos gastos na leitura
+
+    RegisteredGraph() : contentHash(0), loadTime(0.0) {}
+
+    // Limite inferior do span para (p, q), calculado na primeira consulta
+    int lowerBound(int p, int q);
+};
+
+// Registro LRU de grafos já lidos, chaveado pelo arquivo da instância e pelo
+// hash do seu conteúdo. Enquanto tamanho e data de modificação não mudam o
+// arquivo nem é relido; se mudaram, o hash decide se é preciso ler de novo.
+// Requisições simultâneas pela mesma instância aguardam uma única leitura.
+class GraphRegistry {
+private:
+    struct Entry {
+        std::string instance;
+        std::size_t size;
+        long long mtime;  // Nanossegundos (MappedFile::stat)
+        uint64_t hash;
+        std::shared_future<std::shared_ptr<RegisteredGraph>> graph;
+    };
+
+    std::size_t capacity;
+    GraphOptions options;
+    std::mutex mutex;
+    std::list<Entry> entries;  // Mais recente primeiro
+    long long hits;
+    long long misses;
+    long long evictions;
+
+    // Leitura de uma entrada recém-criada; remove a entrada se falhar
+    std::shared_ptr<RegisteredGraph> load(const std::string& instance, uint64_t hash,
+                                          std::promise<std::shared_ptr<RegisteredGraph>>& promise);
+    void removeEntry(const std::string& instance, uint64_t hash);
+
+public:
+    GraphRegistry(std::size_t capacity, const GraphOptions& options);
+
+    // Grafo da instância, lido se ausente ou alterado (nullptr se não puder
+    // ser lido). cached indica se o grafo já estava no registro.
+    std::shared_ptr<RegisteredGraph> acquire(const std::string& instance, bool& cached);
+
+    // Estatísticas e conteúdo atual em JSON (objeto sem chaves externas)
+    std::string statsJSON();
+
+    // Hash FNV-1a de 64 bits do conteúdo do arquivo; false se não puder ser lido
+    static bool hashFile(const std::string& filename, uint64_t& hash);
+};
+
+#endif
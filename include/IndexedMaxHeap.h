@@ -0,0 +1,45 @@
+#ifndef INDEXEDMAXHEAP_H
+#define INDEXEDMAXHEAP_H
+
+#include <cstddef>
+#include <vector>
+
+// Heap binário de máximo sobre vértices, com chaves inteiras de 64 bits.
+// Guarda a posição de cada vértice no heap, então aumentar a chave de um
+// vértice presente custa O(log n). Empates ficam com o menor vértice, o que
+// torna a ordem de retirada determinística.
+class IndexedMaxHeap {
+private:
+    std::vector<int> heap;        // Vértices em ordem de heap
+    std::vector<int> position;    // Posição no heap (-1 se ausente)
+    std::vector<long long> keys;  // Chave atual de cada vértice
+
+    bool above(int a, int b) const {
+        return keys[a] > keys[b] || (keys[a] == keys[b] && a < b);
+    }
+    void place(std::size_t index, int vertex) {
+        heap[index] = vertex;
+        position[vertex] = static_cast<int>(index);
+    }
+    void siftUp(std::size_t index);
+    void siftDown(std::size_t index);
+
+public:
+    // Esvazia a estrutura para n vértices
+    void reset(int n);
+
+    void push(int vertex, long long key);
+
+    // Aumenta a chave de um vértice presente (chaves menores são ignoradas)
+    void increase(int vertex, long long key);
+
+    // Remove e retorna o vértice de maior chave
+    int pop();
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return static_cast<int>(heap.size()); }
+    bool contains(int vertex) const { return position[vertex] != -1; }
+    long long key(int vertex) const { return keys[vertex]; }
+};
+
+#endif
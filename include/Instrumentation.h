@@ -0,0 +1,109 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Contadores de caminho crítico e tempo por fase de uma execução.
+// Só são alimentados quando o projeto é compilado com LPQ_INSTRUMENT
+// (make INSTRUMENT=1); sem a opção as macros abaixo não geram código.
+// Os contadores são atômicos (relaxed) e podem ser somados por várias
+// threads; o tempo das fases executadas em paralelo é a soma entre threads.
+class Instrumentation {
+public:
+    enum Counter {
+        IsValidColorCalls,
+        SmallestColorQueries, // Buscas da menor cor válida (mapa de bits ou vizinhança)
+        ForbiddenRowUpdates,  // Linhas do mapa de cores proibidas atualizadas ao colorir
+        Constructions,
+        CostUpdates,          // Custos recalculados na construção incremental
+        CostUpdatesAvoided,   // Vértices não afetados (custo não recalculado)
+        RclSelections,
+        RclSizeTotal,         // Soma dos tamanhos da RCL (média = total / seleções)
+        LocalSearchPasses,
+        LocalSearchMoves,     // Vértices recoloridos pela busca local
+        TabuIterations,
+        RelinkPaths,          // Caminhos de path relinking percorridos
+        RelinkMoves,          // Vértices que receberam a cor do guia
+        ExactNodes,           // Nós (atribuições) da busca exata
+        ExactSteals,          // Subproblemas tomados da fila de outra thread
+        NumCounters
+    };
+    
+    enum Phase {
+        Load,          // Leitura completa do grafo (inclui Distance2)
+        Distance2,     // Construção da vizinhança a distância 2
+        Construction,
+        LocalSearch,
+        Improvement,   // Busca tabu
+        Validation,
+        PathRelinking, // Inclui a busca local da melhor solução do caminho
+        Exact,         // Branch-and-bound (todas as threads, tempo de parede)
+        NumPhases
+    };
+    
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    
+    // Acumula o tempo de uma fase do construtor ao destrutor (stats pode ser nulo)
+    class ScopedTimer {
+    private:
+        Instrumentation* stats;
+        Phase phase;
+        TimePoint start;
+    
+    public:
+        ScopedTimer(Instrumentation* target, Phase timedPhase)
+            : stats(target), phase(timedPhase), start(now()) {}
+        ~ScopedTimer() {
+            if (stats != nullptr) stats->addTime(phase, now() - start);
+        }
+    };
+    
+    Instrumentation();
+    
+    void add(Counter counter, long long amount) {
+        counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+    void addTime(Phase phase, std::chrono::steady_clock::duration elapsed) {
+        phaseNanos[phase].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                    std::memory_order_relaxed);
+    }
+    
+    // Soma os valores de other (ex.: tempos de leitura guardados no grafo)
+    void merge(const Instrumentation& other);
+    
+    long long get(Counter counter) const { return counters[counter].load(); }
+    double seconds(Phase phase) const { return phaseNanos[phase].load() * 1e-9; }
+    
+    static const char* name(Counter counter);
+    static const char* name(Phase phase);
+    static TimePoint now() { return std::chrono::steady_clock::now(); }
+    
+    // true quando compilado com LPQ_INSTRUMENT
+    static bool enabled();
+    
+    // {"counters": {...}, "phases": {...}} (tempos em segundos)
+    std::string toJSON() const;
+
+private:
+    std::atomic<long long> counters[NumCounters];
+    std::atomic<long long> phaseNanos[NumPhases];
+};
+
+#ifdef LPQ_INSTRUMENT
+#define LPQ_COUNT(stats, counter, amount) \
+    do { if ((stats) != nullptr) (stats)->add(Instrumentation::counter, (amount)); } while (0)
+#define LPQ_TIME_SCOPE(stats, phase) \
+    Instrumentation::ScopedTimer lpqPhaseTimer((stats), Instrumentation::phase)
+#define LPQ_TIMER_START(timer) auto timer = Instrumentation::now()
+#define LPQ_TIMER_STOP(timer, stats, phase) \
+    do { if ((stats) != nullptr) (stats)->addTime(Instrumentation::phase, Instrumentation::now() - timer); } while (0)
+#else
+#define LPQ_COUNT(stats, counter, amount) do { } while (0)
+#define LPQ_TIME_SCOPE(stats, phase) do { } while (0)
+#define LPQ_TIMER_START(timer) do { } while (0)
+#define LPQ_TIMER_STOP(timer, stats, phase) do { } while (0)
+#endif
+
+#endif
@@ -2,8 +2,16 @@
 #define LPQCOLORING_H
 
 #include "Graph.h"
+#include "ForbiddenColors.h"
+#include "CostBuckets.h"
+#include "SearchControl.h"
+#include "ConstraintKernels.h"
+#include "SolutionValidator.h"
+#include "Instrumentation.h"
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <atomic>
 
 struct Solution {
     std::vector<int> coloring;  // coloring[v] = cor do vértice v
@@ -13,40 +21,99 @@ struct Solution {
     Solution(int n) : coloring(n, -1), maxColor(0) {}
 };
 
+// Resumo de LPQColoring::repair
+struct RepairReport {
+    int checked;    // Extremos de arestas novas verificados
+    int recolored;  // Vértices recoloridos (em conflito ou novos)
+    int improved;   // Vértices que desceram de cor na melhoria local
+    
+    RepairReport() : checked(0), recolored(0), improved(0) {}
+};
+
+class ConstructionWorkspace;
+
 class LPQColoring {
+    friend class Benchmark;  // bench/Benchmark.cpp mede as etapas internas
+    
 private:
     Graph* graph;
     int p;  // Diferença mínima para vértices adjacentes
     int q;  // Diferença mínima para vértices a distância 2
+    const ConstraintKernels* kernels;  // Núcleos das restrições escolhidos para (p, q)
     
-    std::mt19937 rng;
+    unsigned int seed;
+    int numThreads;  // Threads usadas nas iterações GRASP
+    SearchControl* control;  // Tempo limite e histórico de melhorias (opcional)
+    int lowerBound;          // Limite inferior conhecido para maxColor (-1 = desconhecido)
+    Instrumentation* instrumentation;  // Contadores da execução (com LPQ_INSTRUMENT; opcional)
+    int eliteSize;           // Tamanho do pool elite do reactive (0 = sem path relinking)
+    Solution initial;        // Solução inicial dos laços GRASP (vazia = nenhuma)
+    
+    // true quando o tempo limite da execução foi atingido
+    bool timeExpired() const { return control != nullptr && control->expired(); }
+    
+    // Gerador da thread lógica threadIndex, derivado da semente mestre
+    std::mt19937 makeThreadRng(int threadIndex) const;
     
     // Verifica se uma cor é válida para um vértice
     bool isValidColor(int vertex, int color, const std::vector<int>& coloring) const;
     
-    // Encontra a menor cor válida para um vértice
-    int findSmallestValidColor(int vertex, const std::vector<int>& coloring) const;
+    // Menor cor não proibida para o vértice no mapa forbidden
+    int smallestAllowed(int vertex, const ForbiddenColors& forbidden) const;
     
-    // Encontra conjunto de cores válidas para um vértice
-    std::vector<int> getValidColors(int vertex, const std::vector<int>& coloring, int maxColorSoFar) const;
+    // Colore um vértice e proíbe as cores conflitantes nos vizinhos não coloridos
+    void assignColor(int vertex, int color, Solution& sol, ForbiddenColors& forbidden) const;
     
-    // Busca local para melhorar solução
-    Solution localSearch(Solution sol, int maxIterations = 100);
+    // Menor cor válida abaixo de limit (retorna limit se não houver), usando
+    // scratch como mapa de cores proibidas de uma linha
+    int smallestValidColorBelow(int vertex, int limit, const std::vector<int>& coloring,
+                                ForbiddenColors& scratch) const;
+    
+    // Busca local para melhorar sol no lugar: desce os vértices da classe mais
+    // alta até esvaziá-la (histograma de cores + classes de cor); as estruturas
+    // auxiliares vêm do workspace. Não melhora soluções construídas pela menor
+    // cor válida, então só é aplicada às soluções do path relinking
+    void localSearch(Solution& sol, int maxIterations, ConstructionWorkspace& workspace) const;
     
     // Calcula grau de saturação de um vértice
     int calculateSaturationDegree(int vertex, const std::vector<int>& coloring) const;
     
     // Calcula custo de um vértice para seleção
-    double calculateVertexCost(int vertex, const std::vector<int>& coloring) const;
-    
-    // Constrói solução usando algoritmo guloso randomizado (uma iteração)
-    Solution buildSolution(double alpha);
-    
-    // Versão otimizada que recalcula apenas custos afetados
-    Solution buildSolutionIncremental(double alpha);
-    
-    // Seleciona vértice da RCL baseado em custos e alpha
-    int selectVertexFromRCL(const std::vector<std::pair<double, int>>& costs, double alpha);
+    int calculateVertexCost(int vertex, const std::vector<int>& coloring,
+                            const ForbiddenColors& forbidden) const;
+    
+    // Constrói solução usando algoritmo guloso randomizado (uma iteração);
+    // o resultado fica em workspace.solution
+    void buildSolution(double alpha, std::mt19937& rng, ConstructionWorkspace& workspace) const;
+    
+    // Versão otimizada que recalcula apenas custos afetados; os custos ficam
+    // numa fila de baldes com contagens em árvore de Fenwick, e cada seleção da
+    // RCL e atualização de custo custa O(log B), B = largura do intervalo de
+    // custos: O((n + m₂) log B) por construção, fora a busca da menor cor
+    void buildSolutionIncremental(double alpha, std::mt19937& rng, ConstructionWorkspace& workspace) const;
+    
+    // Seleciona vértice da RCL baseado em custos (ordenados) e alpha
+    int selectVertexFromRCL(const std::vector<std::pair<int, int>>& costs, double alpha,
+                            std::mt19937& rng) const;
+    
+    // Seleciona vértice da RCL diretamente da fila de baldes, sem ordenar
+    int selectVertexFromRCL(const CostBuckets& queue, double alpha, std::mt19937& rng) const;
+    
+    // Caminha de from até guide atribuindo, um a um, a cor do guia aos vértices
+    // que diferem (a cada passo, o que desloca menos vizinhos entre alguns
+    // sorteados); os vizinhos em conflito recebem a menor cor válida. A melhor solução intermediária
+    // recebe busca local e fica em workspace.solution. Retorna false se não
+    // houver solução intermediária (soluções quase iguais) ou o tempo acabar.
+    bool pathRelinking(const Solution& from, const Solution& guide, std::mt19937& rng,
+                       ConstructionWorkspace& workspace) const;
+    
+    // Coloca a solução inicial (se houver) como melhor da thread 0, na iteração
+    // -1; se ela já atinge o limite inferior, nenhuma iteração roda
+    bool seedThreadBest(std::vector<Solution>& threadBest, std::vector<int>& threadBestIter,
+                        std::atomic<int>& boundHitIter) const;
+    
+    // Escolhe a melhor entre as soluções das threads de forma determinística
+    Solution mergeThreadBest(std::vector<Solution>& threadBest, const std::vector<int>& threadBestIter) const;
     
     // Atualiza probabilidades dos alphas baseado na qualidade observada
     void updateProbabilities(std::vector<double>& probabilities, 
@@ -54,18 +121,64 @@ private:
                             const std::vector<size_t>& blockUsage);
 
 public:
-    LPQColoring(Graph* g, int p_val, int q_val, unsigned int seed);
+    LPQColoring(Graph* g, int p_val, int q_val, unsigned int seed_val);
+    
+    // Define o número de threads das iterações GRASP (resultado determinístico por semente e threads)
+    void setNumThreads(int threads);
+    int getNumThreads() const { return numThreads; }
+    
+    // Associa um controle de tempo/histórico; os laços GRASP e a busca local
+    // param ao atingir o limite e retornam a melhor solução até então
+    void setSearchControl(SearchControl* searchControl) { control = searchControl; }
+    
+    // Limite inferior para maxColor (ver LowerBound); os laços GRASP e a busca
+    // local param assim que uma solução o atinge. -1 desativa a parada.
+    void setLowerBound(int bound) { lowerBound = bound; }
+    
+    // Tamanho do pool elite do reactive: a cada bloco, cada thread liga por path
+    // relinking sua melhor solução a outra do pool e, ao final, todos os pares
+    // do pool combinado são ligados. 0 (padrão) desativa.
+    void setElitePool(int size) { eliteSize = std::max(0, size); }
+    
+    // Solução de partida dos laços GRASP (ex.: dsatur()): é a melhor conhecida
+    // antes da primeira iteração, que só a substitui se for melhor
+    void setInitialSolution(const Solution& sol) { initial = sol; }
+    
+    // Destino dos contadores e tempos por fase (só usados com LPQ_INSTRUMENT)
+    void setInstrumentation(Instrumentation* stats) { instrumentation = stats; }
     
     // Algoritmo Guloso
     Solution greedy();
     
+    // DSATUR para L(p,q): colore a cada passo o vértice não colorido com mais
+    // cores proibidas (empate: maior grau em G e G², depois menor índice) com
+    // sua menor cor viável. Número de cores proibidas e menor cor viável de cada
+    // vértice são mantidos incrementalmente, e a escolha usa um heap indexado:
+    // O((n + m₂) log n), determinístico.
+    Solution dsatur();
+    
     // Algoritmo Guloso Randomizado
     Solution greedyRandomized(double alpha, int iterations);
     
     // Algoritmo Guloso Randomizado Reativo
     Solution greedyRandomizedReactive(const std::vector<double>& alphas, int iterations, int blockSize);
     
-    // Verifica se uma solução é válida
+    // Ajusta sol a alterações já aplicadas ao grafo (Graph::applyChange).
+    // Conflitos novos vêm de arestas novas e, quando q > p, de arestas
+    // removidas cujos extremos ficam a distância 2 (vizinho comum) e passam a
+    // precisar de q. Nos dois casos os extremos em conflito perdem a cor e, com
+    // os vértices novos, recebem a menor cor válida. Depois,
+    // os vértices envolvidos e seus vizinhos tentam descer de cor por até
+    // improvementPasses passadas. O custo depende das vizinhanças alteradas;
+    // só percorre a coloração inteira se um vértice deixar a maior cor.
+    RepairReport repair(Solution& sol, const std::vector<GraphChange>& changes,
+                        int improvementPasses = 2) const;
+    
+    // Validação completa (paralela, com as threads do solver) com contagem
+    // das violações por tipo e as primeiras maxReported
+    ValidationReport validate(const Solution& sol, int maxReported = 10) const;
+    
+    // Verifica se uma solução é válida (imprime o resumo das violações)
     bool isSolutionValid(const Solution& sol) const;
 };
 
@@ -0,0 +1,38 @@
+#ifndef LOWERBOUND_H
+#define LOWERBOUND_H
+
+#include "Graph.h"
+#include <vector>
+
+// Limites inferiores para o span (maior cor, com cores a partir de 0) de uma
+// L(p,q)-coloração. Qualquer solução com maxColor igual a value é ótima.
+struct LowerBoundInfo {
+    int maxDegree;
+    int degreeBound;        // Estrela do vértice de grau máximo: p + (Δ-1)q quando p >= q, Δp senão
+    int cliqueSize;         // Maior clique encontrada em G
+    int cliqueBound;        // (tamanho - 1) * p
+    int squareCliqueSize;   // Maior clique encontrada em G² (vértices a distância <= 2)
+    int squareCliqueBound;  // (tamanho - 1) * min(p, q)
+    int value;              // Maior dos limites acima
+    
+    LowerBoundInfo() : maxDegree(0), degreeBound(0), cliqueSize(0), cliqueBound(0),
+                       squareCliqueSize(0), squareCliqueBound(0), value(0) {}
+};
+
+class LowerBound {
+private:
+    // Clique gulosa a partir de start: candidatos em ordem decrescente de grau,
+    // filtrados pela vizinhança (em G ou em G²) de cada vértice incluído
+    static int greedyClique(Graph* graph, int start, bool square,
+                            std::vector<int>& mark, int& stamp);
+
+public:
+    // Limite da estrela de um vértice de grau maxDegree (vale para quaisquer p, q)
+    static int degreeBound(int maxDegree, int p, int q);
+    
+    // Calcula todos os limites; a busca de cliques parte dos maxStarts
+    // vértices de maior grau (em G e em G², separadamente)
+    static LowerBoundInfo compute(Graph* graph, int p, int q, int maxStarts = 64);
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+// Arquivo mapeado em memória somente para leitura (mmap)
+class MappedFile {
+private:
+    const char* bytes;
+    std::size_t length;
+    long long modificationTime;  // Nanossegundos
+
+public:
+    MappedFile();
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    // Mapeia o arquivo; retorna false se não puder ser aberto
+    bool open(const std::string& filename);
+    void close();
+    
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+    long long mtime() const { return modificationTime; }
+    
+    // Tamanho e data de modificação (em nanossegundos, para que duas escritas
+    // no mesmo segundo não pareçam o mesmo arquivo) sem mapear o arquivo
+    static bool stat(const std::string& filename, std::size_t& size, long long& mtime);
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef NEIGHBORSCAN_H
+#define NEIGHBORSCAN_H
+
+#include <cstddef>
+
+// Varredura de uma lista contígua de vizinhos em busca de uma cor próxima
+// demais: reúne (gather) as cores dos vizinhos em vetores, calcula
+// |color - coloring[w]| contra a cor replicada e para no primeiro conflito.
+// A implementação (AVX2, SSE4.1 ou escalar) é escolhida uma única vez
+// conforme o processador (CPUID).
+class NeighborScan {
+public:
+    enum class Isa { Scalar, SSE4, AVX2 };
+    
+    // Índice i do primeiro vizinho ids[i] já colorido (cor != -1) com
+    // |color - coloring[ids[i]]| < limit, ou -1 se não houver
+    static int firstWithin(const int* ids, std::size_t count, const int* coloring, int color, int limit);
+    
+    // Mesma operação com uma implementação específica (usada no benchmark);
+    // isa deve ser suportada pelo processador
+    static int firstWithin(Isa isa, const int* ids, std::size_t count, const int* coloring,
+                           int color, int limit);
+    
+    // Caso limit = 1 (p = 1 ou q = 1): índice do primeiro vizinho com cor
+    // igual a color (color >= 0), sem subtração nem teste de vizinho sem cor
+    static int firstEqual(const int* ids, std::size_t count, const int* coloring, int color);
+    static int firstEqual(Isa isa, const int* ids, std::size_t count, const int* coloring, int color);
+    
+    // Melhor implementação suportada por este processador
+    static Isa bestSupported();
+    static const char* name(Isa isa);
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SEARCHCONTROL_H
+#define SEARCHCONTROL_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+
+// Ponto do histórico de melhorias (curvas tempo-alvo)
+struct TracePoint {
+    double elapsed;       // Segundos desde o início da execução
+    long long iteration;  // Iteração da fase que encontrou a melhoria
+    int bestMaxColor;     // Melhor maior cor conhecida até então
+    std::string phase;    // Fase que encontrou a melhoria (ex.: "construction", "tabu")
+};
+
+// Orçamento de tempo compartilhado por todas as fases de uma execução e
+// registro opcional das melhorias (anytime). Seguro para várias threads.
+class SearchControl {
+private:
+    std::chrono::steady_clock::time_point start;
+    double timeLimit;  // Segundos (0 = sem limite)
+    std::atomic<bool> timedOut;
+    
+    bool tracing;
+    std::mutex traceMutex;
+    int bestKnown;
+    std::vector<TracePoint> trace;
+
+public:
+    explicit SearchControl(double timeLimitSeconds = 0.0, bool recordTrace = false);
+    
+    // Relógio iniciado em startTime (ex.: chegada de uma requisição do serviço)
+    SearchControl(double timeLimitSeconds, bool recordTrace, std::chrono::steady_clock::time_point startTime);
+    
+    double elapsed() const;
+    
+    // Segundos restantes (valor negativo se não houver limite)
+    double remaining() const;
+    
+    // true quando o tempo limite foi atingido
+    bool expired();
+    bool wasInterrupted() const { return timedOut; }
+    
+    // Registra uma solução com a maior cor informada; só entra no histórico
+    // se melhorar a melhor conhecida
+    void report(long long iteration, int maxColor, const char* phase);
+    
+    const std::vector<TracePoint>& getTrace() const { return trace; }
+    
+    // Grava o histórico em CSV (elapsed,iteration,bestMaxColor,phase)
+    bool saveTrace(const std::string& filename) const;
+};
+
+#endif
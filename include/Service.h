@@ -0,0 +1,69 @@
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include "Graph.h"
+#include "GraphRegistry.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+struct ServiceOptions {
+    std::string socketPath;        // Socket Unix; vazio = stdin/stdout
+    int workers;                   // Requisições resolvidas em paralelo
+    std::size_t registryCapacity;  // Grafos mantidos em memória
+    double timeLimit;              // Tempo limite padrão por requisição (0 = sem limite)
+    GraphOptions graphOptions;
+
+    ServiceOptions() : workers(1), registryCapacity(32), timeLimit(0.0) {}
+};
+
+// Modo serviço: processo de longa duração que recebe requisições JSON, uma
+// por linha, pela entrada padrão ou por um socket Unix, e responde uma linha
+// JSON por requisição assim que ela termina (a ordem das respostas pode
+// diferir da dos pedidos; o campo "id" é devolvido como recebido). Os grafos
+// ficam no registro entre requisições, então o custo de cada uma é só o da
+// resolução. Ver README para o formato das mensagens.
+class SolverService {
+private:
+    // Destino das respostas de um cliente
+    struct Connection {
+        int input;
+        int output;
+        bool owned;  // Fecha output ao final (clientes do socket, em que input == output)
+        std::mutex writeMutex;
+
+        Connection(int input, int output, bool owned) : input(input), output(output), owned(owned) {}
+        ~Connection();
+        void send(const std::string& line);
+    };
+
+    ServiceOptions options;
+    GraphRegistry registry;
+    ThreadPool pool;
+    std::atomic<bool> stopping;
+    int listenFd;
+    std::mutex clientsMutex;
+    std::set<int> clients;  // Conexões abertas (interrompidas no encerramento)
+    std::condition_variable clientsDone;
+
+    // Lê linhas de input até o fim da entrada ou o encerramento do serviço
+    void serveConnection(std::shared_ptr<Connection> connection);
+    void handleLine(const std::string& line, const std::shared_ptr<Connection>& connection);
+    void requestShutdown();
+
+    int runStdio();
+    int runSocket();
+
+public:
+    explicit SolverService(const ServiceOptions& options);
+
+    // Atende requisições até "shutdown" ou o fim da entrada; retorna o código de saída
+    int run();
+};
+
+#endif
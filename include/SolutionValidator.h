@@ -0,0 +1,47 @@
+#ifndef SOLUTIONVALIDATOR_H
+#define SOLUTIONVALIDATOR_H
+
+#include "Graph.h"
+#include <vector>
+
+// Par de vértices (u < v) cujas cores violam uma restrição
+struct ConstraintViolation {
+    int u;
+    int v;
+    bool adjacent;  // true: restrição p (distância 1); false: restrição q (distância 2)
+};
+
+// Resultado da validação de uma coloração
+struct ValidationReport {
+    long long uncolored;            // Vértices sem cor (-1)
+    long long distance1Violations;  // Pares adjacentes com |cu - cv| < p
+    long long distance2Violations;  // Pares a distância 2 com |cu - cv| < q
+    std::vector<ConstraintViolation> violations;  // Primeiras violações, em ordem de u
+    
+    ValidationReport() : uncolored(0), distance1Violations(0), distance2Violations(0) {}
+    
+    long long totalViolations() const { return distance1Violations + distance2Violations; }
+    bool valid() const { return uncolored == 0 && totalViolations() == 0; }
+};
+
+// Validação completa de uma coloração L(p,q). Cada par não ordenado é
+// verificado uma única vez (u < v, aproveitando as listas CSR ordenadas) e
+// faixas de vértices são divididas entre threads. O relatório é o mesmo
+// para qualquer número de threads.
+class SolutionValidator {
+private:
+    Graph* graph;
+    int p;
+    int q;
+    int numThreads;
+
+public:
+    SolutionValidator(Graph* g, int p_val, int q_val);
+    
+    void setNumThreads(int threads);
+    
+    // Conta todas as violações e guarda as primeiras maxReported
+    ValidationReport validate(const std::vector<int>& coloring, int maxReported = 10) const;
+};
+
+#endif
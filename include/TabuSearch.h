@@ -0,0 +1,66 @@
+#ifndef TABUSEARCH_H
+#define TABUSEARCH_H
+
+#include "Graph.h"
+#include "LPQColoring.h"
+#include "SearchControl.h"
+#include <cstddef>
+#include <vector>
+#include <random>
+
+// Busca tabu de mínimos conflitos para L(p,q)-coloring.
+// Fixa um span alvo k (cores 0..k, começando em maxColor-1) e minimiza o
+// número de pares que violam as restrições p/q. Mantém uma tabela de
+// conflitos por (vértice, cor), atualizada incrementalmente a cada movimento.
+// Ao zerar os conflitos, registra a solução e passa a k-1.
+class TabuSearch {
+private:
+    Graph* graph;
+    int p;
+    int q;
+    std::mt19937 rng;
+    
+    long long iterationLimit;  // Limite total de iterações (0 = sem limite)
+    double timeLimit;          // Limite de tempo em segundos (0 = sem limite)
+    long long iterations;      // Iterações executadas na última chamada
+    SearchControl* control;    // Tempo limite global e histórico (opcional)
+    int lowerBound;            // Alvo mínimo de span (-1 = desconhecido)
+    Instrumentation* instrumentation;  // Contadores da execução (opcional)
+    std::size_t memoryLimit;   // Bytes das tabelas de conflitos e tabu (0 = sem limite)
+    
+    int width;                      // Colunas das tabelas (cores 0..width-1)
+    std::vector<int> conflicts;     // conflicts[v*width + c]: conflitos de v se tiver cor c
+    std::vector<long long> tabuUntil;
+    std::vector<int> conflicting;   // Vértices com algum conflito
+    std::vector<int> conflictingPos;
+    
+    // Soma (sign=+1) ou remove (sign=-1) a contribuição da cor color de vertex
+    // nas tabelas dos vizinhos
+    void applyColor(int vertex, int color, int sign);
+    
+    // Atualiza a presença de v na lista de vértices em conflito
+    void refreshConflicting(int vertex, const std::vector<int>& coloring);
+    
+    // Tenta eliminar os conflitos com cores 0..k; retorna true se conseguir
+    bool solveSpan(int k, std::vector<int>& coloring, double deadline);
+
+public:
+    TabuSearch(Graph* g, int p_val, int q_val, unsigned int seed);
+    
+    void setIterationLimit(long long limit) { iterationLimit = limit; }
+    void setTimeLimit(double seconds) { timeLimit = seconds; }
+    
+    // Acima deste tamanho (n × maxColor × 12 bytes) a busca é ignorada
+    void setMemoryLimit(std::size_t bytes) { memoryLimit = bytes; }
+    void setSearchControl(SearchControl* searchControl) { control = searchControl; }
+    
+    // Não tenta spans abaixo do limite inferior (seriam inviáveis)
+    void setLowerBound(int bound) { lowerBound = bound; }
+    void setInstrumentation(Instrumentation* stats) { instrumentation = stats; }
+    long long getIterations() const { return iterations; }
+    
+    // Melhora uma solução válida; retorna a melhor solução válida encontrada
+    Solution improve(const Solution& initial);
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Pool fixo de threads com fila de tarefas
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    int pending;      // Tarefas enfileiradas ou em execução
+    bool stopping;
+    
+    void workerLoop();
+
+public:
+    explicit ThreadPool(int numThreads);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    int size() const { return static_cast<int>(workers.size()); }
+    
+    // Enfileira uma tarefa
+    void submit(std::function<void()> task);
+    
+    // Aguarda todas as tarefas enfileiradas terminarem
+    void wait();
+    
+    // Executa func(i) para i em [0, count) e aguarda o término
+    void parallelFor(int count, const std::function<void(int)>& func);
+    
+    // Número de threads de hardware (no mínimo 1)
+    static int hardwareThreads();
+};
+
+#endif
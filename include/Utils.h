@@ -3,6 +3,7 @@
 
 #include "LPQColoring.h"
 #include <string>
+#include <vector>
 #include <chrono>
 
 // Estrutura para armazenar resultados de execução
@@ -20,10 +21,15 @@ struct ExecutionResult {
     int bestSolution;
     double avgSolution;
     double bestAlpha;
+    int threads;
+    int lowerBound;  // Limite inferior para a maior cor
+    double gap;      // (bestSolution - lowerBound) / bestSolution; 0 = ótimo comprovado
+    std::string instrumentation;  // JSON de contadores/fases (vazio sem LPQ_INSTRUMENT)
     
     ExecutionResult() : p(0), q(0), alpha(""), iterations(0), blockSize(0), 
                         seed(0), executionTime(0.0), bestSolution(0), 
-                        avgSolution(0.0), bestAlpha(0.0) {}
+                        avgSolution(0.0), bestAlpha(0.0), threads(1),
+                        lowerBound(0), gap(0.0) {}
 };
 
 class Utils {
@@ -31,15 +37,35 @@ public:
     // Gera timestamp atual
     static std::string getCurrentDateTime();
     
-    // Salva resultado em CSV
-    static void saveResultToCSV(const ExecutionResult& result, const std::string& filename);
+    // Salva resultado em CSV (false se não foi possível gravar)
+    static bool saveResultToCSV(const ExecutionResult& result, const std::string& filename);
     
-    // Cria header do CSV se necessário
-    static void createCSVHeaderIfNeeded(const std::string& filename);
+    // Salva vários resultados em uma única escrita bufferizada
+    static bool saveResultsToCSV(const std::vector<ExecutionResult>& results, const std::string& filename);
+    
+    // Arquivo JSON Lines com a instrumentação, ao lado do CSV
+    // (results/results.csv -> results/results.instrument.jsonl)
+    static std::string instrumentationFile(const std::string& csvFile);
+    
+    // Formata uma linha do CSV (com '\n')
+    static std::string formatCSVRow(const ExecutionResult& result);
+    
+    // Cabeçalho do CSV de resultados (sem '\n')
+    static const char* csvHeader();
+    
+    // Cria header do CSV se necessário. Retorna false se o arquivo já existe
+    // com outro cabeçalho (colunas de outra versão): nada deve ser acrescentado
+    static bool createCSVHeaderIfNeeded(const std::string& filename);
     
     // Imprime solução em formato visualizável
     static void printSolution(const Solution& sol, const std::string& filename = "");
     
+    // Lê alterações de topologia, uma por linha, com IDs 1-based como no DIMACS:
+    //   e+ u v (nova aresta)   e- u v (remove aresta)
+    //   v+     (novo vértice)  v- u   (remove as arestas de u)
+    // Linhas vazias e iniciadas por 'c' são ignoradas.
+    static bool readGraphChanges(const std::string& filename, std::vector<GraphChange>& changes);
+    
     // Gera semente baseada em data/hora
     static unsigned int generateSeed();
     
@@ -51,49 +51,29 @@ echo "Resultados serão salvos em: $CSV_FILE"
 echo ""
 
 # ========================================
-# 1. ALGORITMO GULOSO
+# PLANO DE EXPERIMENTOS
 # ========================================
-echo "----------------------------------------"
-echo "1. Executando Algoritmo Guloso"
-echo "----------------------------------------"
-for i in $(seq 1 $NUM_EXECUCOES); do
-    echo "  Execução $i/$NUM_EXECUCOES..."
-    $EXECUTABLE -f "$INSTANCE" -p $P -q $Q -a greedy -csv "$CSV_FILE"
-done
-echo "Guloso: Concluído!"
-echo ""
+# Todas as configurações rodam em um único processo (modo -batch): a instância
+# é lida e pré-processada uma vez e o CSV é gravado ao final.
+PLAN_FILE=$(mktemp)
+trap 'rm -f "$PLAN_FILE"' EXIT
 
-# ========================================
-# 2. ALGORITMO GULOSO RANDOMIZADO
-# ========================================
-echo "----------------------------------------"
-echo "2. Executando Algoritmo Guloso Randomizado"
-echo "----------------------------------------"
-for alpha in "${ALPHAS[@]}"; do
-    echo "  Alpha = $alpha"
-    for i in $(seq 1 $NUM_EXECUCOES); do
-        echo "    Execução $i/$NUM_EXECUCOES..."
-        $EXECUTABLE -f "$INSTANCE" -p $P -q $Q -a randomized \
-                    -alpha $alpha -i $ITER_RANDOMIZED -csv "$CSV_FILE"
-    done
-done
-echo "Guloso Randomizado: Concluído!"
-echo ""
+cat > "$PLAN_FILE" <<EOF
+instance $INSTANCE
+pq $P $Q
+algorithms greedy randomized reactive
+alphas ${ALPHAS[*]}
+iterations randomized $ITER_RANDOMIZED
+iterations reactive $ITER_REACTIVE
+block $BLOCK_SIZE
+seeds 1..$NUM_EXECUCOES
+csv $CSV_FILE
+EOF
 
-# ========================================
-# 3. ALGORITMO GULOSO RANDOMIZADO REATIVO
-# ========================================
 echo "----------------------------------------"
-echo "3. Executando Algoritmo Guloso Randomizado Reativo"
+echo "Executando guloso, randomizado e reativo"
 echo "----------------------------------------"
-ALPHAS_STR=$(IFS=,; echo "${ALPHAS[*]}")
-for i in $(seq 1 $NUM_EXECUCOES); do
-    echo "  Execução $i/$NUM_EXECUCOES..."
-    $EXECUTABLE -f "$INSTANCE" -p $P -q $Q -a reactive \
-                -alphas "$ALPHAS_STR" -i $ITER_REACTIVE -b $BLOCK_SIZE \
-                -csv "$CSV_FILE"
-done
-echo "Guloso Randomizado Reativo: Concluído!"
+$EXECUTABLE -batch "$PLAN_FILE" -t "${THREADS:-0}"
 echo ""
 
 # ========================================
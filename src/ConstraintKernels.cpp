@@ -0,0 +1,108 @@
+#include "../include/ConstraintKernels.h"
+#include "../include/NeighborScan.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Posição do primeiro vizinho da lista com cor a menos de limit de color (-1 se nenhum).
+// LIMIT é o valor fixado em tempo de compilação (0 = genérico); com LIMIT = 1
+// a varredura é só de igualdade
+template<int LIMIT>
+inline int scanRange(const NeighborRange& range, const std::vector<int>& coloring, int color, int limit) {
+    if (LIMIT == 1) return NeighborScan::firstEqual(range.data(), range.size(), coloring.data(), color);
+    return NeighborScan::firstWithin(range.data(), range.size(), coloring.data(), color, limit);
+}
+
+// P = Q = 0 indica o caso genérico (valores lidos em tempo de execução)
+template<int P, int Q>
+struct Kernel {
+    static int pValue(int p) { return P > 0 ? P : p; }
+    static int qValue(int q) { return Q > 0 ? Q : q; }
+    
+    static bool isValidColor(const Graph& graph, int p, int q, int vertex, int color,
+                             const std::vector<int>& coloring) {
+        const int pv = pValue(p), qv = qValue(q);
+        
+        // Listas contíguas: varredura vetorizada (ver NeighborScan)
+        if (scanRange<P>(graph.getNeighbors(vertex), coloring, color, pv) >= 0) return false;
+        if (!graph.isDistance2Implicit()) {
+            return scanRange<Q>(graph.getDistance2Neighbors(vertex), coloring, color, qv) < 0;
+        }
+        
+        return !graph.anyDistance2Neighbor(vertex, [&](int neighbor2) {
+            auto c = coloring[neighbor2];
+            return c != -1 && std::abs(color - c) < qv;
+        });
+    }
+    
+    static int forbidAround(const Graph& graph, int p, int q, int vertex, int color,
+                            const std::vector<int>& coloring, ForbiddenColors& forbidden) {
+        const int pv = pValue(p), qv = qValue(q);
+        auto updated = 0;
+        
+        // Vizinhos diretos não podem usar cores em [color-p+1, color+p-1]
+        for (auto neighbor : graph.getNeighbors(vertex)) {
+            if (coloring[neighbor] == -1) {
+                if (pv == 1) forbidden.forbidColor(neighbor, color);
+                else forbidden.forbidRange(neighbor, color - pv + 1, color + pv - 1);
+                updated++;
+            }
+        }
+        
+        // Vizinhos a distância 2 não podem usar cores em [color-q+1, color+q-1]
+        graph.forEachDistance2Neighbor(vertex, [&](int neighbor2) {
+            if (coloring[neighbor2] == -1) {
+                if (qv == 1) forbidden.forbidColor(neighbor2, color);
+                else forbidden.forbidRange(neighbor2, color - qv + 1, color + qv - 1);
+                updated++;
+            }
+        });
+        return updated;
+    }
+    
+    static int smallestValidColorBelow(const Graph& graph, int p, int q, int vertex, int limit,
+                                       const std::vector<int>& coloring, ForbiddenColors& scratch) {
+        const int pv = pValue(p), qv = qValue(q);
+        
+        // Monta a linha de cores proibidas do vértice, ignorando cores >= limit
+        scratch.reset(1);
+        for (auto neighbor : graph.getNeighbors(vertex)) {
+            auto c = coloring[neighbor];
+            if (c != -1) {
+                scratch.forbidRange(0, c - pv + 1, std::min(c + pv - 1, limit - 1));
+            }
+        }
+        graph.forEachDistance2Neighbor(vertex, [&](int neighbor2) {
+            auto c = coloring[neighbor2];
+            if (c != -1) {
+                scratch.forbidRange(0, c - qv + 1, std::min(c + qv - 1, limit - 1));
+            }
+        });
+        
+        return std::min(scratch.smallestAllowed(0), limit);
+    }
+    
+    static ConstraintKernels table(const char* name) {
+        ConstraintKernels kernels;
+        kernels.isValidColor = &isValidColor;
+        kernels.forbidAround = &forbidAround;
+        kernels.smallestValidColorBelow = &smallestValidColorBelow;
+        kernels.name = name;
+        return kernels;
+    }
+};
+
+}
+
+const ConstraintKernels& ConstraintKernels::select(int p, int q) {
+    static const ConstraintKernels kernels21 = Kernel<2, 1>::table("(2,1)");
+    static const ConstraintKernels kernels11 = Kernel<1, 1>::table("(1,1)");
+    static const ConstraintKernels kernels32 = Kernel<3, 2>::table("(3,2)");
+    static const ConstraintKernels generic = Kernel<0, 0>::table("genérico");
+    
+    if (p == 2 && q == 1) return kernels21;
+    if (p == 1 && q == 1) return kernels11;
+    if (p == 3 && q == 2) return kernels32;
+    return generic;
+}
@@ -0,0 +1,22 @@
+#include "../include/ConstructionWorkspace.h"
+#include <algorithm>
+
+void ConstructionWorkspace::reset(int n) {
+    if (static_cast<int>(solution.coloring.size()) != n) {
+        solution.coloring.assign(n, -1);
+        forbidden.reset(n);
+        queue.reset(n);
+        saturation.assign(n, 0);
+        classPosition.assign(n, 0);
+        uncolored.reserve(n);
+        costs.reserve(n);
+        worklist.reserve(n);
+    } else {
+        // Toda construção colore todos os vértices: a solução e o mapa de cores
+        // proibidas são limpos; saturation e queue já terminam zerados/vazios
+        std::fill(solution.coloring.begin(), solution.coloring.end(), -1);
+        forbidden.clear();
+        if (!queue.empty()) queue.clear();
+    }
+    solution.maxColor = 0;
+}
@@ -0,0 +1,158 @@
+#include "../include/CostBuckets.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+CostBuckets::CostBuckets() : base(0), lowest(0), highest(-1), count(0) {
+}
+
+void CostBuckets::reset(int n) {
+    buckets.clear();
+    tree.clear();
+    base = 0;
+    lowest = 0;
+    highest = -1;
+    costOf.assign(n, 0);
+    position.assign(n, -1);
+    count = 0;
+}
+
+void CostBuckets::clear() {
+    for (auto index = lowest; index <= highest; index++) {
+        for (auto vertex : buckets[index]) position[vertex] = -1;
+        if (!buckets[index].empty()) addToTree(index, -static_cast<int>(buckets[index].size()));
+        buckets[index].clear();
+    }
+    lowest = 0;
+    highest = -1;
+    count = 0;
+}
+
+void CostBuckets::ensureRange(int cost) {
+    auto size = static_cast<int>(buckets.size());
+    if (size > 0 && cost >= base && cost < base + size) return;
+    
+    // Novo intervalo com folga de metade do atual (ou 64) nos dois lados
+    auto slack = std::max(64, size / 2);
+    auto newBase = size == 0 ? cost - slack : std::min(base, cost - slack);
+    auto newEnd = size == 0 ? cost + slack + 1 : std::max(base + size, cost + slack + 1);
+    
+    std::vector<std::vector<int>> grown(newEnd - newBase);
+    auto shift = base - newBase;
+    for (auto index = 0; index < size; index++) {
+        grown[index + shift].swap(buckets[index]);
+    }
+    buckets.swap(grown);
+    
+    // Reconstrução linear da árvore de Fenwick
+    auto newSize = static_cast<int>(buckets.size());
+    tree.assign(newSize + 1, 0);
+    for (auto index = 1; index <= newSize; index++) {
+        tree[index] += static_cast<int>(buckets[index - 1].size());
+        auto parent = index + (index & -index);
+        if (parent <= newSize) tree[parent] += tree[index];
+    }
+    if (count > 0) {
+        lowest += shift;
+        highest += shift;
+    }
+    base = newBase;
+}
+
+void CostBuckets::addToTree(int index, int delta) {
+    auto size = static_cast<int>(tree.size()) - 1;
+    for (auto i = index + 1; i <= size; i += i & -i) tree[i] += delta;
+}
+
+int CostBuckets::prefixCount(int index) const {
+    auto total = 0;
+    for (auto i = index + 1; i > 0; i -= i & -i) total += tree[i];
+    return total;
+}
+
+int CostBuckets::findRank(int rank) const {
+    auto size = static_cast<int>(tree.size()) - 1;
+    auto step = 1;
+    while (step * 2 <= size) step *= 2;
+    
+    // Desce pelos nós da árvore acumulando os baldes inteiros antes do rank
+    auto index = 0;
+    for (; step > 0; step /= 2) {
+        if (index + step <= size && tree[index + step] <= rank) {
+            index += step;
+            rank -= tree[index];
+        }
+    }
+    return index;  // Índice (base 0) do balde
+}
+
+void CostBuckets::detach(int vertex) {
+    auto index = costOf[vertex] - base;
+    auto& bucket = buckets[index];
+    
+    // Swap-and-pop dentro do balde, corrigindo a posição do vértice movido
+    auto last = bucket.back();
+    bucket[position[vertex]] = last;
+    position[last] = position[vertex];
+    bucket.pop_back();
+    position[vertex] = -1;
+    addToTree(index, -1);
+    count--;
+    
+    // Mantém [lowest, highest] justo nos baldes não vazios
+    if (count == 0) {
+        lowest = 0;
+        highest = -1;
+    } else if (bucket.empty()) {
+        if (index == lowest) lowest = findRank(0);
+        if (index == highest) highest = findRank(count - 1);
+    }
+}
+
+void CostBuckets::update(int vertex, int cost) {
+    if (position[vertex] != -1) {
+        if (costOf[vertex] == cost) return;
+        detach(vertex);
+    }
+    
+    ensureRange(cost);
+    auto index = cost - base;
+    auto& bucket = buckets[index];
+    costOf[vertex] = cost;
+    position[vertex] = static_cast<int>(bucket.size());
+    bucket.push_back(vertex);
+    addToTree(index, 1);
+    if (count == 0) {
+        lowest = index;
+        highest = index;
+    } else {
+        lowest = std::min(lowest, index);
+        highest = std::max(highest, index);
+    }
+    count++;
+}
+
+void CostBuckets::remove(int vertex) {
+    if (position[vertex] != -1) {
+        detach(vertex);
+    }
+}
+
+int CostBuckets::countUpTo(double threshold) const {
+    if (count == 0 || threshold < base + lowest) return 0;
+    if (threshold >= base + highest) return count;
+    
+    // Custos são inteiros: custo <= threshold equivale a custo <= floor(threshold)
+    auto index = static_cast<int>(std::floor(threshold)) - base;
+    return prefixCount(index);
+}
+
+int CostBuckets::selectUpTo(double threshold, std::mt19937& rng) const {
+    std::uniform_int_distribution<int> dist(0, countUpTo(threshold) - 1);
+    auto rank = dist(rng);
+    
+    // rank-ésimo vértice em ordem de (custo, posição no balde)
+    auto bucket = findRank(rank);
+    auto before = bucket > 0 ? prefixCount(bucket - 1) : 0;
+    return buckets[bucket][rank - before];
+}
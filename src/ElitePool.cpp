@@ -0,0 +1,70 @@
+#include "../include/ElitePool.h"
+#include <climits>
+
+ElitePool::ElitePool(std::size_t capacity, int minDistance)
+    : capacity(capacity), minDistance(minDistance < 1 ? 1 : minDistance) {
+    members.reserve(capacity);
+    memberIters.reserve(capacity);
+}
+
+int ElitePool::distance(const Solution& a, const Solution& b) {
+    auto differences = 0;
+    for (std::size_t v = 0; v < a.coloring.size(); v++) {
+        if (a.coloring[v] != b.coloring[v]) differences++;
+    }
+    return differences;
+}
+
+std::size_t ElitePool::best() const {
+    std::size_t bestIndex = 0;
+    for (std::size_t i = 1; i < members.size(); i++) {
+        if (members[i].maxColor < members[bestIndex].maxColor ||
+            (members[i].maxColor == members[bestIndex].maxColor && memberIters[i] < memberIters[bestIndex])) {
+            bestIndex = i;
+        }
+    }
+    return bestIndex;
+}
+
+bool ElitePool::offer(const Solution& sol, int iteration) {
+    if (capacity == 0) return false;
+
+    // Distância ao pool e membro substituível mais parecido (não melhor que sol;
+    // empate na distância fica com o de maior maxColor)
+    auto isBest = true;
+    auto nearest = INT_MAX;
+    auto replace = members.size();
+    auto replaceDistance = INT_MAX;
+    for (std::size_t i = 0; i < members.size(); i++) {
+        auto d = distance(sol, members[i]);
+        if (d == 0) return false;
+        if (d < nearest) nearest = d;
+        if (members[i].maxColor <= sol.maxColor) isBest = false;
+        if (members[i].maxColor >= sol.maxColor &&
+            (d < replaceDistance ||
+             (d == replaceDistance && members[i].maxColor > members[replace].maxColor))) {
+            replace = i;
+            replaceDistance = d;
+        }
+    }
+    if (!isBest && nearest < minDistance) return false;
+
+    if (members.size() < capacity) {
+        members.push_back(sol);
+        memberIters.push_back(iteration);
+        return true;
+    }
+    if (replace == members.size()) return false;  // Todos os membros são melhores
+
+    // Atribuição reaproveita o buffer do membro substituído
+    members[replace].coloring = sol.coloring;
+    members[replace].maxColor = sol.maxColor;
+    memberIters[replace] = iteration;
+    return true;
+}
+
+void ElitePool::merge(const ElitePool& other) {
+    for (std::size_t i = 0; i < other.members.size(); i++) {
+        offer(other.members[i], other.memberIters[i]);
+    }
+}
@@ -0,0 +1,359 @@
+#include "../include/ExactSolver.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+using namespace std;
+
+namespace {
+
+typedef vector<pair<int, int>> Assignments;  // Prefixo de um subproblema: (vértice, cor)
+
+// Estado da busca de uma thread para um span k: domínios em bitset (cores
+// 0..k), tamanhos dos domínios, cores atribuídas e uma trilha com tudo o que
+// foi alterado, desfeita em ordem LIFO no backtracking
+class BranchState {
+private:
+    struct TrailEntry {
+        int vertex;
+        int word;        // -1: marca a atribuição de vertex
+        uint64_t bits;   // Cores retiradas do domínio nessa palavra
+    };
+
+    Graph* graph;
+    int p;
+    int q;
+    int k;
+    size_t words;
+    const vector<int>* degree;
+
+    vector<uint64_t> domains;   // domains[v*words + w]
+    vector<int> domainSize;
+    vector<int> uncolored;      // Vértices não coloridos nas primeiras uncoloredCount posições
+    vector<int> position;
+    int uncoloredCount;
+    vector<TrailEntry> trail;
+
+    // Retira [lo, hi] do domínio de u; false se o domínio esvaziar
+    bool removeRange(int u, int lo, int hi) {
+        lo = max(lo, 0);
+        hi = min(hi, k);
+        if (lo > hi) return true;
+        auto row = domains.data() + static_cast<size_t>(u) * words;
+        for (auto w = static_cast<size_t>(lo >> 6); w <= static_cast<size_t>(hi >> 6); w++) {
+            auto mask = ~0ULL;
+            if (w == static_cast<size_t>(lo >> 6)) mask &= ~0ULL << (lo & 63);
+            if (w == static_cast<size_t>(hi >> 6)) mask &= ~0ULL >> (63 - (hi & 63));
+            auto removed = row[w] & mask;
+            if (removed == 0) continue;
+            row[w] &= ~removed;
+            domainSize[u] -= __builtin_popcountll(removed);
+            TrailEntry entry = {u, static_cast<int>(w), removed};
+            trail.push_back(entry);
+        }
+        return domainSize[u] > 0;
+    }
+
+public:
+    vector<int> coloring;
+
+    BranchState(Graph* g, int p_val, int q_val, const vector<int>& vertexDegree)
+        : graph(g), p(p_val), q(q_val), k(0), words(0), degree(&vertexDegree),
+          uncoloredCount(0) {}
+
+    // Todos os vértices não coloridos, com domínio 0..span
+    void reset(int span) {
+        auto n = graph->getNumVertices();
+        k = span;
+        words = static_cast<size_t>(k >> 6) + 1;
+        domains.assign(static_cast<size_t>(n) * words, ~0ULL);
+        auto lastMask = ~0ULL >> (63 - (k & 63));
+        for (auto v = 0; v < n; v++) {
+            domains[static_cast<size_t>(v) * words + words - 1] = lastMask;
+        }
+        domainSize.assign(n, k + 1);
+        coloring.assign(n, -1);
+        uncolored.resize(n);
+        position.resize(n);
+        for (auto v = 0; v < n; v++) {
+            uncolored[v] = v;
+            position[v] = v;
+        }
+        uncoloredCount = n;
+        trail.clear();
+    }
+
+    size_t mark() const { return trail.size(); }
+
+    // Desfaz as alterações posteriores a mark
+    void undo(size_t mark) {
+        while (trail.size() > mark) {
+            auto entry = trail.back();
+            trail.pop_back();
+            if (entry.word < 0) {
+                coloring[entry.vertex] = -1;
+                uncoloredCount++;  // O vértice continua na posição uncoloredCount-1
+            } else {
+                domains[static_cast<size_t>(entry.vertex) * words + entry.word] |= entry.bits;
+                domainSize[entry.vertex] += __builtin_popcountll(entry.bits);
+            }
+        }
+    }
+
+    // Atribui color a v e propaga aos vizinhos não coloridos; false se algum
+    // domínio esvaziar (as alterações ficam na trilha para undo)
+    bool assign(int v, int color) {
+        auto last = uncolored[uncoloredCount - 1];
+        auto pos = position[v];
+        uncolored[pos] = last;
+        position[last] = pos;
+        uncolored[uncoloredCount - 1] = v;
+        position[v] = uncoloredCount - 1;
+        uncoloredCount--;
+        coloring[v] = color;
+        TrailEntry entry = {v, -1, 0};
+        trail.push_back(entry);
+
+        if (p > 0) {
+            for (auto neighbor : graph->getNeighbors(v)) {
+                if (coloring[neighbor] == -1 && !removeRange(neighbor, color - p + 1, color + p - 1)) return false;
+            }
+        }
+        if (q > 0) {
+            auto wiped = graph->anyDistance2Neighbor(v, [&](int neighbor2) {
+                return coloring[neighbor2] == -1 && !removeRange(neighbor2, color - q + 1, color + q - 1);
+            });
+            if (wiped) return false;
+        }
+        return true;
+    }
+
+    // Vértice não colorido de menor domínio (empate: maior grau, depois menor
+    // índice); -1 se todos estiverem coloridos
+    int select() const {
+        auto best = -1;
+        for (auto i = 0; i < uncoloredCount; i++) {
+            auto v = uncolored[i];
+            if (best == -1 || domainSize[v] < domainSize[best] ||
+                (domainSize[v] == domainSize[best] &&
+                 ((*degree)[v] > (*degree)[best] || ((*degree)[v] == (*degree)[best] && v < best)))) {
+                best = v;
+            }
+        }
+        return best;
+    }
+
+    // Menor cor do domínio de v em [from, limit]; -1 se não houver
+    int nextColor(int v, int from, int limit) const {
+        if (from > limit) return -1;
+        auto row = domains.data() + static_cast<size_t>(v) * words;
+        auto w = static_cast<size_t>(from >> 6);
+        auto bitsWord = row[w] & (~0ULL << (from & 63));
+        while (true) {
+            if (bitsWord != 0) {
+                auto color = static_cast<int>(w * 64) + __builtin_ctzll(bitsWord);
+                return color <= limit ? color : -1;
+            }
+            if (++w >= words) return -1;
+            bitsWord = row[w];
+        }
+    }
+};
+
+// Nível da pilha de busca: vértice ramificado, cor atual e maior cor permitida
+struct Level {
+    int vertex;
+    int color;
+    int limit;
+    size_t mark;  // Trilha antes da atribuição de vertex
+};
+
+}
+
+ExactSolver::ExactSolver(Graph* g, int p_val, int q_val)
+    : graph(g), p(p_val), q(q_val), numThreads(1), control(nullptr), lowerBound(0),
+      instrumentation(nullptr), provenBound(0), nodes(0) {
+}
+
+bool ExactSolver::searchSpan(int k, Solution& found, bool& interrupted) {
+    auto n = graph->getNumVertices();
+    vector<int> degree(n);
+    for (auto v = 0; v < n; v++) {
+        degree[v] = graph->getDegree(v) + graph->getDistance2Degree(v);
+    }
+
+    // Filas de subproblemas por thread; pending conta os enfileirados e os em
+    // execução, então pending == 0 significa árvore esgotada
+    auto threads = numThreads;
+    vector<deque<Assignments>> queues(threads);
+    vector<mutex> queueMutex(threads);
+    atomic<int> pending(1);
+    atomic<int> idle(0);
+    atomic<bool> stop(false);
+    atomic<bool> timedOut(false);
+    atomic<long long> totalNodes(0);
+    mutex resultMutex;
+    mutex waitMutex;
+    condition_variable workPosted;
+    auto solved = false;
+    queues[0].push_back(Assignments());
+
+    // Próximo subproblema de t: o mais recente da própria fila ou o mais
+    // antigo (mais raso) de outra
+    auto take = [&](int t, Assignments& task) {
+        for (auto i = 0; i < threads; i++) {
+            auto source = (t + i) % threads;
+            lock_guard<mutex> lock(queueMutex[source]);
+            if (queues[source].empty()) continue;
+            if (source == t) {
+                task.swap(queues[source].back());
+                queues[source].pop_back();
+            } else {
+                task.swap(queues[source].front());
+                queues[source].pop_front();
+                LPQ_COUNT(instrumentation, ExactSteals, 1);
+            }
+            return true;
+        }
+        return false;
+    };
+
+    auto ownQueueEmpty = [&](int t) {
+        lock_guard<mutex> lock(queueMutex[t]);
+        return queues[t].empty();
+    };
+
+    ThreadPool pool(threads);
+    pool.parallelFor(threads, [&](int t) {
+        BranchState state(graph, p, q, degree);
+        vector<Level> stack;
+        Assignments task;
+        long long localNodes = 0;
+
+        // Doa as cores ainda não tentadas do nível mais raso que tiver alguma
+        auto donate = [&]() {
+            for (size_t i = 0; i < stack.size(); i++) {
+                auto& level = stack[i];
+                auto c = state.nextColor(level.vertex, level.color + 1, level.limit);
+                if (c < 0) continue;
+
+                Assignments prefix(task);
+                for (size_t j = 0; j < i; j++) prefix.push_back(make_pair(stack[j].vertex, stack[j].color));
+                {
+                    lock_guard<mutex> lock(queueMutex[t]);
+                    for (; c >= 0; c = state.nextColor(level.vertex, c + 1, level.limit)) {
+                        queues[t].push_back(prefix);
+                        queues[t].back().push_back(make_pair(level.vertex, c));
+                        pending++;
+                    }
+                }
+                level.limit = level.color;
+                workPosted.notify_all();
+                return;
+            }
+        };
+
+        while (!stop) {
+            if (!take(t, task)) {
+                if (pending == 0) break;
+                idle++;
+                {
+                    unique_lock<mutex> lock(waitMutex);
+                    workPosted.wait_for(lock, chrono::milliseconds(1));
+                }
+                idle--;
+                continue;
+            }
+
+            // Reaplica o prefixo; a simetria só é quebrada na raiz da árvore
+            state.reset(k);
+            auto feasible = true;
+            for (const auto& assignment : task) {
+                if (!state.assign(assignment.first, assignment.second)) {
+                    feasible = false;
+                    break;
+                }
+            }
+            stack.clear();
+            auto descend = feasible;
+
+            while (!stop) {
+                if (descend) {
+                    auto v = state.select();
+                    if (v == -1) {
+                        lock_guard<mutex> lock(resultMutex);
+                        if (!solved) {
+                            solved = true;
+                            found.coloring = state.coloring;
+                            found.maxColor = *max_element(found.coloring.begin(), found.coloring.end());
+                        }
+                        stop = true;
+                        break;
+                    }
+                    auto limit = task.empty() && stack.empty() ? k / 2 : k;
+                    Level level = {v, -1, limit, state.mark()};
+                    stack.push_back(level);
+                    descend = false;
+                }
+                if (stack.empty()) break;
+
+                // Próxima cor do nível do topo (ou volta um nível)
+                auto& top = stack.back();
+                state.undo(top.mark);
+                auto c = state.nextColor(top.vertex, top.color + 1, top.limit);
+                if (c < 0) {
+                    stack.pop_back();
+                    continue;
+                }
+                top.color = c;
+                localNodes++;
+                descend = state.assign(top.vertex, c);
+
+                if ((localNodes & 255) == 0 && control != nullptr && control->expired()) {
+                    timedOut = true;
+                    stop = true;
+                }
+                if (descend && idle > 0 && ownQueueEmpty(t)) donate();
+            }
+            pending--;
+        }
+        totalNodes += localNodes;
+        LPQ_COUNT(instrumentation, ExactNodes, localNodes);
+    });
+
+    nodes += totalNodes;
+    interrupted = timedOut;
+    return solved;
+}
+
+Solution ExactSolver::solve(const Solution& initial) {
+    LPQ_TIME_SCOPE(instrumentation, Exact);
+    nodes = 0;
+    provenBound = lowerBound;
+
+    // Aperto do span: cada k viável vira incumbente; o primeiro inviável
+    // comprova a otimalidade
+    Solution best = initial;
+    while (best.maxColor > provenBound) {
+        if (control != nullptr && control->expired()) break;
+
+        auto k = best.maxColor - 1;
+        Solution found;
+        auto interrupted = false;
+        if (searchSpan(k, found, interrupted)) {
+            best = found;
+            if (control != nullptr) control->report(k, best.maxColor, "exact");
+        } else if (interrupted) {
+            break;
+        } else {
+            provenBound = best.maxColor;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,413 @@
+#include "../include/Experiment.h"
+#include "../include/ThreadPool.h"
+#include "../include/TabuSearch.h"
+#include "../include/ExactSolver.h"
+#include "../include/LowerBound.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <mutex>
+#include <map>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+// Lê exatamente um valor e exige o fim da linha
+template<typename T>
+bool readSingle(std::istringstream& iss, T& value) {
+    return (iss >> value) && (iss >> std::ws).eof();
+}
+
+// Semente: só dígitos, dentro de unsigned int
+bool parseSeed(const std::string& text, unsigned int& seed) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) return false;
+    errno = 0;
+    auto value = std::strtoull(text.c_str(), nullptr, 10);
+    if (errno != 0 || value > UINT_MAX) return false;
+    seed = static_cast<unsigned int>(value);
+    return true;
+}
+
+}
+
+bool Experiment::isKnownAlgorithm(const std::string& algorithm) {
+    return algorithm == "greedy" || algorithm == "dsatur" || algorithm == "randomized" ||
+           algorithm == "reactive" || algorithm == "exact";
+}
+
+bool Experiment::isKnownImprovement(const std::string& improvement) {
+    return improvement == "none" || improvement == "tabu";
+}
+
+bool Experiment::isKnownInitial(const std::string& initial) {
+    return initial == "none" || initial == "dsatur";
+}
+
+ExecutionResult Experiment::run(Graph* graph, const std::string& instance,
+                                const ExperimentConfig& config, Solution& solution, bool& valid,
+                                const std::chrono::steady_clock::time_point* start) {
+    auto lowerBound = config.lowerBound;
+    if (lowerBound < 0) {
+        lowerBound = LowerBound::compute(graph, config.p, config.q).value;
+    }
+    
+    // O relógio do limite de tempo começa aqui (ou em start) e cobre algoritmo + melhoria
+    SearchControl control(config.timeLimit, !config.traceFile.empty(),
+                          start != nullptr ? *start : std::chrono::steady_clock::now());
+    
+    // Contadores da execução; os tempos de leitura vêm do grafo
+    Instrumentation stats;
+    stats.merge(graph->getLoadStats());
+    
+    LPQColoring solver(graph, config.p, config.q, config.seed);
+    solver.setNumThreads(config.threads);
+    solver.setSearchControl(&control);
+    solver.setInstrumentation(&stats);
+    solver.setLowerBound(config.earlyStop ? lowerBound : -1);
+    solver.setElitePool(config.eliteSize);
+    
+    double executionTime = 0.0;
+    if (config.algorithm == "greedy") {
+        executionTime = Utils::measureExecutionTime([&]() {
+            solution = solver.greedy();
+        });
+    } else if (config.algorithm == "dsatur") {
+        executionTime = Utils::measureExecutionTime([&]() {
+            solution = solver.dsatur();
+        });
+    } else if (config.algorithm == "randomized") {
+        executionTime = Utils::measureExecutionTime([&]() {
+            if (config.initial == "dsatur") solver.setInitialSolution(solver.dsatur());
+            solution = solver.greedyRandomized(config.alpha, config.iterations);
+        });
+    } else if (config.algorithm == "reactive") {
+        executionTime = Utils::measureExecutionTime([&]() {
+            if (config.initial == "dsatur") solver.setInitialSolution(solver.dsatur());
+            solution = solver.greedyRandomizedReactive(config.alphas, config.iterations, config.blockSize);
+        });
+    } else if (config.algorithm == "exact") {
+        // Parte da melhor entre greedy e DSATUR; o limite inferior é usado
+        // mesmo com -lb off, pois só poda spans comprovadamente inviáveis
+        ExactSolver exact(graph, config.p, config.q);
+        exact.setNumThreads(config.threads);
+        exact.setSearchControl(&control);
+        exact.setLowerBound(lowerBound);
+        exact.setInstrumentation(&stats);
+        executionTime = Utils::measureExecutionTime([&]() {
+            auto greedySolution = solver.greedy();
+            auto dsaturSolution = solver.dsatur();
+            solution = exact.solve(dsaturSolution.maxColor < greedySolution.maxColor ?
+                                   dsaturSolution : greedySolution);
+        });
+        lowerBound = exact.getLowerBound();
+    }
+    
+    // Fase de melhoria opcional sobre a solução do algoritmo
+    if (config.improvement == "tabu") {
+        TabuSearch tabu(graph, config.p, config.q, config.seed);
+        tabu.setIterationLimit(config.tabuIterations);
+        tabu.setTimeLimit(config.tabuTimeLimit);
+        tabu.setMemoryLimit(config.tabuMemoryLimit);
+        tabu.setSearchControl(&control);
+        tabu.setLowerBound(config.earlyStop ? lowerBound : -1);
+        tabu.setInstrumentation(&stats);
+        executionTime += Utils::measureExecutionTime([&]() {
+            solution = tabu.improve(solution);
+        });
+    }
+    
+    // Validação na numeração interna; a solução devolvida usa os IDs do arquivo
+    valid = solver.isSolutionValid(solution);
+    solution.coloring = graph->toOriginalOrder(solution.coloring);
+    
+    if (control.wasInterrupted()) {
+        std::cout << "Tempo limite atingido; retornando a melhor solução encontrada" << std::endl;
+    }
+    if (!config.traceFile.empty()) {
+        control.saveTrace(config.traceFile);
+    }
+    
+    ExecutionResult result;
+    result.datetime = Utils::getCurrentDateTime();
+    result.instance = instance;
+    result.p = config.p;
+    result.q = config.q;
+    result.algorithm = config.algorithm;
+    if (config.initial != "none" && (config.algorithm == "randomized" || config.algorithm == "reactive")) {
+        result.algorithm = config.initial + "+" + result.algorithm;
+    }
+    if (config.improvement != "none") {
+        result.algorithm += "+" + config.improvement;
+    }
+    
+    // Preenche coluna alpha apropriadamente para cada algoritmo
+    if (config.algorithm == "randomized") {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2) << config.alpha;
+        result.alpha = oss.str();
+    } else if (config.algorithm == "reactive") {
+        // Para reactive, mostra todos os alphas usados
+        std::ostringstream oss;
+        for (size_t i = 0; i < config.alphas.size(); i++) {
+            oss << std::fixed << std::setprecision(2) << config.alphas[i];
+            if (i < config.alphas.size() - 1) oss << ";";
+        }
+        result.alpha = oss.str();
+    } else {
+        result.alpha = "N/A";
+    }
+    
+    result.iterations = config.iterations;
+    result.blockSize = (config.algorithm == "reactive") ? config.blockSize : 0;
+    result.seed = config.seed;
+    result.threads = config.threads;
+    result.executionTime = executionTime;
+    result.bestSolution = solution.maxColor;
+    result.avgSolution = solution.maxColor;  // Para uma única execução, avg = best
+    result.bestAlpha = (config.algorithm == "randomized") ? config.alpha : 
+                       (config.algorithm == "reactive" && !config.alphas.empty()) ? config.alphas[0] : 0.0;
+    result.lowerBound = lowerBound;
+    if (Instrumentation::enabled()) {
+        result.instrumentation = stats.toJSON();
+    }
+    result.gap = solution.maxColor > 0 ?
+                 static_cast<double>(solution.maxColor - lowerBound) / solution.maxColor : 0.0;
+    
+    return result;
+}
+
+bool Experiment::readPlan(const std::string& filename, ExperimentPlan& plan) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao abrir plano de experimentos: " << filename << std::endl;
+        return false;
+    }
+    
+    plan.instances.clear();
+    plan.pqPairs.clear();
+    plan.algorithms.clear();
+    plan.seeds.clear();
+    
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](const std::string& message) {
+        std::cerr << "Erro no plano (linha " << lineNumber << "): " << message << std::endl;
+        return false;
+    };
+    while (std::getline(file, line)) {
+        lineNumber++;
+        auto comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        
+        std::istringstream iss(line);
+        std::string key;
+        if (!(iss >> key)) continue;
+        
+        std::string value;
+        if (key == "instance") {
+            while (iss >> value) plan.instances.push_back(value);
+        } else if (key == "pq") {
+            int p, q;
+            if (!(iss >> p >> q) || !(iss >> std::ws).eof() || p < 0 || q < 0) {
+                return fail("use 'pq <p> <q>' com inteiros não negativos");
+            }
+            plan.pqPairs.push_back(std::make_pair(p, q));
+        } else if (key == "algorithms") {
+            while (iss >> value) {
+                if (!isKnownAlgorithm(value)) return fail("algoritmo inválido " + value);
+                plan.algorithms.push_back(value);
+            }
+        } else if (key == "alphas") {
+            plan.alphas.clear();
+            double alpha;
+            while (iss >> alpha) {
+                if (alpha < 0.0 || alpha > 1.0) return fail("alpha fora de [0, 1]");
+                plan.alphas.push_back(alpha);
+            }
+            if (!iss.eof() || plan.alphas.empty()) return fail("use 'alphas <a1> <a2> ...' com números");
+        } else if (key == "seeds") {
+            // Lista de sementes ou intervalo "a..b"
+            while (iss >> value) {
+                auto range = value.find("..");
+                unsigned int first, last;
+                if (range != std::string::npos) {
+                    if (!parseSeed(value.substr(0, range), first) || !parseSeed(value.substr(range + 2), last) ||
+                        first > last) {
+                        return fail("intervalo de sementes inválido " + value);
+                    }
+                    for (auto s = first; ; s++) {
+                        plan.seeds.push_back(s);
+                        if (s == last) break;
+                    }
+                } else {
+                    if (!parseSeed(value, first)) return fail("semente inválida " + value);
+                    plan.seeds.push_back(first);
+                }
+            }
+        } else if (key == "ls") {
+            plan.improvements.clear();
+            while (iss >> value) {
+                if (!isKnownImprovement(value)) return fail("busca local inválida " + value);
+                plan.improvements.push_back(value);
+            }
+        } else if (key == "tabu-iter") {
+            if (!readSingle(iss, plan.tabuIterations) || plan.tabuIterations < 0) {
+                return fail("use 'tabu-iter <n>' com n >= 0");
+            }
+        } else if (key == "tabu-time") {
+            if (!readSingle(iss, plan.tabuTimeLimit) || plan.tabuTimeLimit < 0) {
+                return fail("use 'tabu-time <segundos>' com valor >= 0");
+            }
+        } else if (key == "tabu-mem") {
+            long long megabytes;
+            if (!readSingle(iss, megabytes) || megabytes < 0) {
+                return fail("use 'tabu-mem <MB>' com valor >= 0");
+            }
+            plan.tabuMemoryLimit = static_cast<std::size_t>(megabytes) << 20;
+        } else if (key == "time-limit") {
+            if (!readSingle(iss, plan.timeLimit) || plan.timeLimit < 0) {
+                return fail("use 'time-limit <segundos>' com valor >= 0");
+            }
+        } else if (key == "lb") {
+            if (!readSingle(iss, value) || (value != "on" && value != "off")) {
+                return fail("use 'lb on' ou 'lb off'");
+            }
+            plan.earlyStop = value == "on";
+        } else if (key == "iterations") {
+            std::string algorithm;
+            int count;
+            if (!(iss >> algorithm) || (algorithm != "randomized" && algorithm != "reactive") ||
+                !readSingle(iss, count) || count < 1) {
+                return fail("use 'iterations randomized|reactive <n>' com n >= 1");
+            }
+            if (algorithm == "randomized") plan.iterationsRandomized = count;
+            else plan.iterationsReactive = count;
+        } else if (key == "block") {
+            if (!readSingle(iss, plan.blockSize) || plan.blockSize < 1) {
+                return fail("use 'block <n>' com n >= 1");
+            }
+        } else if (key == "elite") {
+            if (!readSingle(iss, plan.eliteSize) || plan.eliteSize < 0) {
+                return fail("use 'elite <n>' com n >= 0");
+            }
+        } else if (key == "init") {
+            if (!readSingle(iss, value) || !isKnownInitial(value)) {
+                return fail("solução inicial inválida " + value);
+            }
+            plan.initial = value;
+        } else if (key == "csv") {
+            if (!readSingle(iss, plan.csvFile)) return fail("use 'csv <arquivo>'");
+        } else {
+            return fail("chave desconhecida " + key);
+        }
+    }
+    
+    if (plan.instances.empty() || plan.pqPairs.empty() || plan.algorithms.empty()) {
+        std::cerr << "Erro: o plano precisa de 'instance', 'pq' e 'algorithms'" << std::endl;
+        return false;
+    }
+    if (plan.seeds.empty()) {
+        plan.seeds.push_back(Utils::generateSeed());
+    }
+    
+    return true;
+}
+
+int Experiment::runPlan(const ExperimentPlan& plan, int workers, const GraphOptions& graphOptions) {
+    // CSV com colunas de outra versão: falha antes de executar a grade
+    if (!Utils::createCSVHeaderIfNeeded(plan.csvFile)) {
+        return 1;
+    }
+    
+    // Grade de configurações (independe da instância)
+    std::vector<ExperimentConfig> grid;
+    for (const auto& pq : plan.pqPairs) {
+        for (const auto& algorithm : plan.algorithms) {
+            std::vector<double> alphaValues(1, 0.0);
+            if (algorithm == "randomized") alphaValues = plan.alphas;
+            
+            for (auto alpha : alphaValues) {
+                for (const auto& improvement : plan.improvements) {
+                    for (auto seed : plan.seeds) {
+                        ExperimentConfig config;
+                        config.algorithm = algorithm;
+                        config.p = pq.first;
+                        config.q = pq.second;
+                        config.alpha = alpha;
+                        config.alphas = plan.alphas;
+                        config.iterations = algorithm == "randomized" ? plan.iterationsRandomized :
+                                            algorithm == "reactive" ? plan.iterationsReactive : 0;
+                        config.blockSize = plan.blockSize;
+                        config.eliteSize = plan.eliteSize;
+                        config.initial = plan.initial;
+                        config.seed = seed;
+                        config.improvement = improvement;
+                        config.tabuIterations = plan.tabuIterations;
+                        config.tabuTimeLimit = plan.tabuTimeLimit;
+                        config.tabuMemoryLimit = plan.tabuMemoryLimit;
+                        config.timeLimit = plan.timeLimit;
+                        config.earlyStop = plan.earlyStop;
+                        grid.push_back(config);
+                    }
+                }
+            }
+        }
+    }
+    
+    std::cout << "Plano: " << plan.instances.size() << " instância(s) x " << grid.size()
+              << " configurações, " << workers << " worker(s)" << std::endl;
+    
+    std::vector<ExecutionResult> results;
+    auto invalidCount = 0;
+    ThreadPool pool(workers);
+    std::mutex outputMutex;
+    
+    for (const auto& instance : plan.instances) {
+        Graph* graph = Graph::readFromFile(instance, graphOptions);
+        if (graph == nullptr) {
+            std::cerr << "Erro ao ler o grafo: " << instance << std::endl;
+            continue;
+        }
+        
+        // Limite inferior calculado uma vez por par (p,q) da instância
+        std::map<std::pair<int, int>, int> lowerBounds;
+        for (const auto& pq : plan.pqPairs) {
+            if (lowerBounds.count(pq) == 0) {
+                lowerBounds[pq] = LowerBound::compute(graph, pq.first, pq.second).value;
+            }
+        }
+        
+        // Cada configuração escreve em sua própria posição: a ordem do CSV é a da grade
+        std::vector<ExecutionResult> instanceResults(grid.size());
+        for (size_t i = 0; i < grid.size(); i++) {
+            pool.submit([&, i]() {
+                Solution solution;
+                bool valid = false;
+                auto config = grid[i];
+                config.lowerBound = lowerBounds.at(std::make_pair(config.p, config.q));
+                instanceResults[i] = run(graph, instance, config, solution, valid);
+                
+                std::lock_guard<std::mutex> lock(outputMutex);
+                if (!valid) invalidCount++;
+                std::cout << "  " << instanceResults[i].algorithm << " p=" << grid[i].p << " q=" << grid[i].q
+                          << " alpha=" << instanceResults[i].alpha << " seed=" << grid[i].seed
+                          << " -> " << solution.maxColor << (valid ? "" : " (INVÁLIDA)")
+                          << " em " << instanceResults[i].executionTime << "s" << std::endl;
+            });
+        }
+        pool.wait();
+        
+        results.insert(results.end(), instanceResults.begin(), instanceResults.end());
+        delete graph;
+    }
+    
+    if (!Utils::saveResultsToCSV(results, plan.csvFile)) {
+        return 1;
+    }
+    std::cout << "\n" << results.size() << " resultados salvos em: " << plan.csvFile << std::endl;
+    
+    return invalidCount == 0 ? 0 : 1;
+}
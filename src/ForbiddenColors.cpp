@@ -0,0 +1,98 @@
+#include "../include/ForbiddenColors.h"
+#include <algorithm>
+
+ForbiddenColors::ForbiddenColors() : numVertices(0), wordsPerVertex(1), usedWords(0) {
+}
+
+void ForbiddenColors::reset(int n) {
+    numVertices = n;
+    usedWords = 0;
+    if (bits.size() == static_cast<std::size_t>(n) * wordsPerVertex) {
+        std::fill(bits.begin(), bits.end(), 0);
+    } else {
+        bits.assign(static_cast<std::size_t>(n) * wordsPerVertex, 0);
+    }
+}
+
+void ForbiddenColors::clear() {
+    if (usedWords == wordsPerVertex) {
+        std::fill(bits.begin(), bits.end(), 0);
+    } else if (usedWords > 0) {
+        for (auto v = 0; v < numVertices; v++) {
+            auto row = bits.begin() + static_cast<std::size_t>(v) * wordsPerVertex;
+            std::fill(row, row + usedWords, 0);
+        }
+    }
+    usedWords = 0;
+}
+
+void ForbiddenColors::grow(int color) {
+    auto newWords = wordsPerVertex;
+    while (newWords * 64 <= static_cast<std::size_t>(color)) {
+        newWords *= 2;
+    }
+    
+    std::vector<uint64_t> newBits(static_cast<std::size_t>(numVertices) * newWords, 0);
+    for (auto v = 0; v < numVertices; v++) {
+        std::copy(bits.begin() + v * wordsPerVertex, bits.begin() + (v + 1) * wordsPerVertex,
+                  newBits.begin() + v * newWords);
+    }
+    
+    bits.swap(newBits);
+    wordsPerVertex = newWords;
+}
+
+int ForbiddenColors::forbidRange(int vertex, int lo, int hi) {
+    if (lo < 0) lo = 0;
+    if (hi < lo) return 0;
+    
+    if (static_cast<std::size_t>(hi) >= wordsPerVertex * 64) {
+        grow(hi);
+    }
+    
+    auto row = bits.data() + static_cast<std::size_t>(vertex) * wordsPerVertex;
+    auto firstWord = lo >> 6;
+    auto lastWord = hi >> 6;
+    if (static_cast<std::size_t>(lastWord) >= usedWords) usedWords = lastWord + 1;
+    auto firstMask = ~0ULL << (lo & 63);
+    auto lastMask = ~0ULL >> (63 - (hi & 63));
+    
+    if (firstWord == lastWord) {
+        auto mask = firstMask & lastMask;
+        auto added = __builtin_popcountll(mask & ~row[firstWord]);
+        row[firstWord] |= mask;
+        return added;
+    }
+    
+    auto added = __builtin_popcountll(firstMask & ~row[firstWord]);
+    row[firstWord] |= firstMask;
+    for (auto w = firstWord + 1; w < lastWord; w++) {
+        added += __builtin_popcountll(~row[w]);
+        row[w] = ~0ULL;
+    }
+    added += __builtin_popcountll(lastMask & ~row[lastWord]);
+    row[lastWord] |= lastMask;
+    return added;
+}
+
+bool ForbiddenColors::isForbidden(int vertex, int color) const {
+    if (static_cast<std::size_t>(color) >= wordsPerVertex * 64) return false;
+    auto row = bits.data() + static_cast<std::size_t>(vertex) * wordsPerVertex;
+    return (row[color >> 6] >> (color & 63)) & 1ULL;
+}
+
+int ForbiddenColors::smallestAllowedFrom(int vertex, int from) const {
+    auto first = static_cast<std::size_t>(from >> 6);
+    if (first >= wordsPerVertex) return from;
+    auto row = bits.data() + static_cast<std::size_t>(vertex) * wordsPerVertex;
+    
+    // Na primeira palavra, as cores abaixo de from contam como proibidas
+    auto free = ~row[first] & (~0ULL << (from & 63));
+    if (free != 0) return static_cast<int>(first * 64) + __builtin_ctzll(free);
+    for (auto w = first + 1; w < wordsPerVertex; w++) {
+        if (row[w] != ~0ULL) {
+            return static_cast<int>(w * 64) + __builtin_ctzll(~row[w]);
+        }
+    }
+    return static_cast<int>(wordsPerVertex * 64);
+}
@@ -0,0 +1,365 @@
+#include "../include/Generator.h"
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+Graph* finish(Graph* graph, const GraphOptions& options) {
+    if (!graph->finalize(options)) {
+        delete graph;
+        return nullptr;
+    }
+    return graph;
+}
+
+}
+
+Graph* Generator::random(int n, double avgDegree, unsigned int seed, const GraphOptions& options) {
+    Graph* graph = new Graph(n);
+    if (n < 2) return finish(graph, options);
+    
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertexDist(0, n - 1);
+    auto edges = static_cast<long long>(n * avgDegree / 2);
+    
+    // Laços são descartados por addEdge e arestas repetidas pelo CSR
+    for (long long e = 0; e < edges; e++) {
+        graph->addEdge(vertexDist(rng), vertexDist(rng));
+    }
+    return finish(graph, options);
+}
+
+Graph* Generator::geometric(int n, double avgDegree, unsigned int seed, const GraphOptions& options) {
+    Graph* graph = new Graph(n);
+    if (n < 2) return finish(graph, options);
+    
+    // Grau esperado ≈ n·π·r² (desconsiderando as bordas)
+    auto radius = std::sqrt(avgDegree / (n * M_PI));
+    auto cells = std::max(1, static_cast<int>(1.0 / radius));
+    
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordDist(0.0, 1.0);
+    std::vector<double> x(n), y(n);
+    for (auto v = 0; v < n; v++) {
+        x[v] = coordDist(rng);
+        y[v] = coordDist(rng);
+    }
+    
+    // Grade de células de lado >= raio: basta comparar com as 9 células vizinhas
+    auto cellOf = [&](double coord) { return std::min(cells - 1, static_cast<int>(coord * cells)); };
+    std::vector<std::vector<int>> grid(static_cast<std::size_t>(cells) * cells);
+    for (auto v = 0; v < n; v++) {
+        grid[static_cast<std::size_t>(cellOf(y[v])) * cells + cellOf(x[v])].push_back(v);
+    }
+    
+    auto radius2 = radius * radius;
+    for (auto v = 0; v < n; v++) {
+        auto cx = cellOf(x[v]), cy = cellOf(y[v]);
+        for (auto gy = std::max(0, cy - 1); gy <= std::min(cells - 1, cy + 1); gy++) {
+            for (auto gx = std::max(0, cx - 1); gx <= std::min(cells - 1, cx + 1); gx++) {
+                for (auto w : grid[static_cast<std::size_t>(gy) * cells + gx]) {
+                    auto dx = x[v] - x[w], dy = y[v] - y[w];
+                    if (w > v && dx * dx + dy * dy < radius2) {
+                        graph->addEdge(v, w);
+                    }
+                }
+            }
+        }
+    }
+    return finish(graph, options);
+}
+
+namespace {
+
+// Salto geométrico: quantos pares são pulados até o próximo sorteado com
+// probabilidade p (0 < p < 1), como double para não estourar em p pequeno
+double geometricSkip(std::mt19937_64& rng, double logOneMinusP) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    return std::floor(std::log(1.0 - unit(rng)) / logOneMinusP);
+}
+
+// G(n, p): para cada u, os v > u sorteados são alcançados por saltos
+// geométricos, em O(n + m)
+class RandomStream : public EdgeStream {
+private:
+    int n;
+    double p;
+    unsigned int seed;
+
+public:
+    RandomStream(int vertices, double probability, unsigned int s)
+        : n(vertices), p(probability), seed(s) {}
+    
+    int numVertices() const override { return n; }
+    
+    void forEachEdge(const std::function<void(int, int)>& emit) const override {
+        if (p <= 0.0) return;
+        std::mt19937_64 rng(seed);
+        auto logOneMinusP = std::log(1.0 - p);
+        for (auto u = 0; u < n - 1; u++) {
+            double v = u;
+            while (true) {
+                v += p >= 1.0 ? 1.0 : 1.0 + geometricSkip(rng, logOneMinusP);
+                if (v >= n) break;
+                emit(u, static_cast<int>(v));
+            }
+        }
+    }
+};
+
+// Disco unitário. Os pontos são numerados por célula (linha a linha) de uma
+// grade de lado >= raio: vizinhos ficam na mesma célula ou nas adjacentes,
+// com IDs próximos, e os v > u estão na própria célula, na seguinte da
+// linha e nas três da linha de baixo, nessa ordem crescente.
+class GeometricStream : public EdgeStream {
+private:
+    int n;
+    int cells;
+    double radius2;
+    std::vector<double> x, y;
+    std::vector<int> cellStart;  // Pontos da célula c: [cellStart[c], cellStart[c+1])
+
+public:
+    GeometricStream(int vertices, double avgDegree, unsigned int seed) : n(vertices) {
+        auto radius = std::sqrt(avgDegree / (n * M_PI));
+        auto maxCells = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n))));
+        cells = std::max(1, std::min(maxCells, static_cast<int>(1.0 / radius)));
+        radius2 = radius * radius;
+        
+        // Duas passadas com a mesma semente: conta os pontos por célula e
+        // depois os coloca nas posições finais, sem cópia intermediária
+        auto cellOf = [&](double coord) { return std::min(cells - 1, static_cast<int>(coord * cells)); };
+        std::uniform_real_distribution<double> coordDist(0.0, 1.0);
+        cellStart.assign(static_cast<std::size_t>(cells) * cells + 1, 0);
+        std::mt19937_64 rng(seed);
+        for (auto i = 0; i < n; i++) {
+            auto px = coordDist(rng);
+            auto py = coordDist(rng);
+            cellStart[static_cast<std::size_t>(cellOf(py)) * cells + cellOf(px) + 1]++;
+        }
+        for (std::size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+        
+        std::vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+        x.resize(n);
+        y.resize(n);
+        rng.seed(seed);
+        for (auto i = 0; i < n; i++) {
+            auto px = coordDist(rng);
+            auto py = coordDist(rng);
+            auto v = cursor[static_cast<std::size_t>(cellOf(py)) * cells + cellOf(px)]++;
+            x[v] = px;
+            y[v] = py;
+        }
+    }
+    
+    int numVertices() const override { return n; }
+    
+    void forEachEdge(const std::function<void(int, int)>& emit) const override {
+        for (auto cy = 0; cy < cells; cy++) {
+            for (auto cx = 0; cx < cells; cx++) {
+                auto cell = static_cast<std::size_t>(cy) * cells + cx;
+                for (auto u = cellStart[cell]; u < cellStart[cell + 1]; u++) {
+                    auto visit = [&](int first, int last) {
+                        for (auto v = first; v < last; v++) {
+                            auto dx = x[u] - x[v], dy = y[u] - y[v];
+                            if (dx * dx + dy * dy < radius2) emit(u, v);
+                        }
+                    };
+                    visit(u + 1, cellStart[cell + 1]);
+                    if (cx + 1 < cells) visit(cellStart[cell + 1], cellStart[cell + 2]);
+                    if (cy + 1 < cells) {
+                        auto below = cell + cells;
+                        auto first = cx > 0 ? below - 1 : below;
+                        auto last = cx + 1 < cells ? below + 1 : below;
+                        visit(cellStart[first], cellStart[last + 1]);
+                    }
+                }
+            }
+        }
+    }
+};
+
+// Grades de ⌈√n⌉ colunas (última linha possivelmente incompleta). Na
+// hexagonal, as linhas ímpares estão deslocadas meia célula à direita.
+class GridStream : public EdgeStream {
+private:
+    int n;
+    int width;
+    bool hexagonal;
+
+public:
+    GridStream(int vertices, bool hex) : n(vertices), hexagonal(hex) {
+        width = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n)))));
+    }
+    
+    int numVertices() const override { return n; }
+    
+    void forEachEdge(const std::function<void(int, int)>& emit) const override {
+        for (auto u = 0; u < n; u++) {
+            auto row = u / width, col = u % width;
+            if (col + 1 < width && u + 1 < n) emit(u, u + 1);
+            
+            auto below = u + width;
+            if (!hexagonal) {
+                if (below < n) emit(u, below);
+                continue;
+            }
+            // Linha par: vizinhos abaixo em col-1 e col; ímpar: col e col+1
+            auto first = row % 2 == 0 ? col - 1 : col;
+            for (auto c = std::max(0, first); c <= first + 1 && c < width; c++) {
+                auto v = (row + 1) * width + c;
+                if (v < n) emit(u, v);
+            }
+        }
+    }
+};
+
+// Chung–Lu: P(u, v) = min(1, w_u w_v / S), com pesos w_i ∝ (i+1)^(-1/(γ-1))
+// (grau esperado de i ≈ w_i) e S = Σ w. Como os pesos decrescem com o
+// índice, P(u, v) é não crescente em v e os candidatos são percorridos com
+// saltos geométricos e rejeição (Miller–Hagberg), em O(n + m) esperado.
+class PowerLawStream : public EdgeStream {
+private:
+    int n;
+    double totalWeight;
+    std::vector<double> weight;
+    unsigned int seed;
+
+public:
+    PowerLawStream(int vertices, double avgDegree, double exponent, unsigned int s)
+        : n(vertices), totalWeight(0.0), weight(vertices), seed(s) {
+        auto decay = -1.0 / (exponent - 1.0);
+        for (auto i = 0; i < n; i++) {
+            weight[i] = std::pow(i + 1.0, decay);
+            totalWeight += weight[i];
+        }
+        auto scale = n * avgDegree / totalWeight;
+        for (auto& w : weight) w *= scale;
+        totalWeight = n * avgDegree;
+    }
+    
+    int numVertices() const override { return n; }
+    
+    void forEachEdge(const std::function<void(int, int)>& emit) const override {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        auto probability = [&](int u, int v) { return std::min(1.0, weight[u] * weight[v] / totalWeight); };
+        
+        for (auto u = 0; u < n - 1; u++) {
+            double v = u + 1;
+            auto p = probability(u, u + 1);
+            while (v < n && p > 0.0) {
+                if (p < 1.0) v += geometricSkip(rng, std::log(1.0 - p));
+                if (v >= n) break;
+                auto target = static_cast<int>(v);
+                auto actual = probability(u, target);
+                if (unit(rng) < actual / p) emit(u, target);
+                p = actual;
+                v += 1;
+            }
+        }
+    }
+};
+
+}
+
+std::unique_ptr<EdgeStream> Generator::stream(GraphFamily family, int n, double avgDegree,
+                                              unsigned int seed, double exponent) {
+    if (n < 1) return nullptr;
+    bool needsDegree = family != GraphFamily::Grid && family != GraphFamily::Hexagonal;
+    if (needsDegree && !(avgDegree > 0.0)) return nullptr;
+    
+    switch (family) {
+        case GraphFamily::Random:
+            return std::unique_ptr<EdgeStream>(
+                new RandomStream(n, n > 1 ? std::min(1.0, avgDegree / (n - 1)) : 0.0, seed));
+        case GraphFamily::Geometric:
+            return std::unique_ptr<EdgeStream>(new GeometricStream(n, avgDegree, seed));
+        case GraphFamily::Grid:
+            return std::unique_ptr<EdgeStream>(new GridStream(n, false));
+        case GraphFamily::Hexagonal:
+            return std::unique_ptr<EdgeStream>(new GridStream(n, true));
+        case GraphFamily::PowerLaw:
+            if (!(exponent > 2.0)) return nullptr;
+            return std::unique_ptr<EdgeStream>(new PowerLawStream(n, avgDegree, exponent, seed));
+    }
+    return nullptr;
+}
+
+bool Generator::parseFamily(const std::string& name, GraphFamily& family) {
+    if (name == "random") family = GraphFamily::Random;
+    else if (name == "geometric") family = GraphFamily::Geometric;
+    else if (name == "grid") family = GraphFamily::Grid;
+    else if (name == "hex") family = GraphFamily::Hexagonal;
+    else if (name == "powerlaw") family = GraphFamily::PowerLaw;
+    else return false;
+    return true;
+}
+
+const char* Generator::familyName(GraphFamily family) {
+    switch (family) {
+        case GraphFamily::Random: return "random";
+        case GraphFamily::Geometric: return "geometric";
+        case GraphFamily::Grid: return "grid";
+        case GraphFamily::Hexagonal: return "hex";
+        case GraphFamily::PowerLaw: return "powerlaw";
+    }
+    return "?";
+}
+
+long long Generator::writeDimacs(const EdgeStream& edges, const std::string& filename,
+                                 const std::string& comment) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar arquivo: " << filename << std::endl;
+        return -1;
+    }
+    
+    const int countWidth = 20;  // Cabe qualquer long long
+    if (!comment.empty()) file << "c " << comment << "\n";
+    file << "p edge " << edges.numVertices() << " ";
+    auto countPosition = file.tellp();
+    file << std::string(countWidth, ' ') << "\n";
+    
+    // Linhas formatadas à mão em um buffer, descarregado a cada ~1 MB
+    std::string buffer;
+    buffer.reserve((1 << 20) + 64);
+    long long count = 0;
+    char digits[16];
+    auto append = [&](int value) {
+        auto length = 0;
+        do {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) buffer += digits[--length];
+    };
+    edges.forEachEdge([&](int u, int v) {
+        buffer += "e ";
+        append(u + 1);
+        buffer += ' ';
+        append(v + 1);
+        buffer += '\n';
+        count++;
+        if (buffer.size() >= (1 << 20)) {
+            file.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    });
+    file.write(buffer.data(), buffer.size());
+    
+    auto countText = std::to_string(count);
+    file.seekp(countPosition);
+    file.write(countText.data(), countText.size());
+    
+    if (!file) {
+        std::cerr << "Erro ao gravar arquivo: " << filename << std::endl;
+        return -1;
+    }
+    return count;
+}
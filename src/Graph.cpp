@@ -1,121 +1,918 @@
 #include "../include/Graph.h"
+#include "../include/ThreadPool.h"
+#include "../include/MappedFile.h"
+#include "../include/Generator.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <queue>
+#include <cstring>
+#include <cstdint>
+#include <climits>
 
-Graph::Graph(int n) : numVertices(n) {
-    adjList.resize(n);
-    distance2Neighbors.resize(n);
+namespace {
+
+// Percorre os vizinhos de vizinhos dos vértices dos blocos t, t+T, t+2T, ...
+// usando um marcador por thread (mark[w] == v indica w já visto para v)
+// no lugar de buscas lineares e inserções em conjunto
+template<typename Visit>
+void visitDistance2Chunks(const Graph& graph, int t, int threads, int chunkSize,
+                          std::vector<int>& mark, Visit visit) {
+    auto n = graph.getNumVertices();
+    auto numChunks = (n + chunkSize - 1) / chunkSize;
+    
+    for (auto chunk = t; chunk < numChunks; chunk += threads) {
+        auto last = std::min(n, (chunk + 1) * chunkSize);
+        for (auto v = chunk * chunkSize; v < last; v++) {
+            mark[v] = v;
+            for (int neighbor : graph.getNeighbors(v)) {
+                mark[neighbor] = v;
+            }
+            for (int neighbor : graph.getNeighbors(v)) {
+                for (int neighbor2 : graph.getNeighbors(neighbor)) {
+                    if (mark[neighbor2] != v) {
+                        mark[neighbor2] = v;
+                        visit(v, neighbor2);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Cabeçalho do cache binário. Seguem, alinhados a 8 bytes: adjOffsets (n+1),
+// adjIndices, originalIds (n, se houver renumeração) e, se presentes,
+// d2Offsets (n+1) e d2Indices.
+struct GraphCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t hasDistance2;
+    uint32_t vertexOrder;
+    uint32_t reserved;
+    uint64_t numVertices;
+    uint64_t adjCount;
+    uint64_t d2Count;
+    uint64_t sourceSize;
+    int64_t sourceMtime;    // Nanossegundos: regravações no mesmo segundo invalidam o cache
+};
+
+const char CACHE_MAGIC[8] = {'L', 'P', 'Q', 'G', 'R', 'A', 'P', 'H'};
+const uint32_t CACHE_VERSION = 3;  // 3: sourceMtime em nanossegundos (antes, segundos)
+
+static_assert(sizeof(std::size_t) == sizeof(uint64_t), "offsets do cache exigem size_t de 64 bits");
+
+std::size_t alignTo8(std::size_t bytes) {
+    return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+// CSR lido do cache: offsets começam em 0, nunca diminuem e terminam em
+// count, e todo índice está em [0, n). Sem isso, um arquivo corrompido leva a
+// acessos fora do mapeamento
+bool validCSR(const std::size_t* offsets, const int* indices, std::size_t n, std::size_t count) {
+    if (offsets[0] != 0 || offsets[n] != count) return false;
+    for (std::size_t v = 0; v < n; v++) {
+        if (offsets[v + 1] < offsets[v]) return false;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        if (indices[i] < 0 || static_cast<std::size_t>(indices[i]) >= n) return false;
+    }
+    return true;
+}
+
+// Numeração original: permutação de 0..n-1
+bool validPermutation(const int* ids, std::size_t n) {
+    std::vector<char> seen(n, 0);
+    for (std::size_t v = 0; v < n; v++) {
+        if (ids[v] < 0 || static_cast<std::size_t>(ids[v]) >= n || seen[ids[v]]) return false;
+        seen[ids[v]] = 1;
+    }
+    return true;
+}
+
+// Leitura de inteiros sem locale/istringstream sobre o buffer mapeado
+inline const char* skipBlanks(const char* ptr, const char* end) {
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')) ptr++;
+    return ptr;
+}
+
+inline const char* skipLine(const char* ptr, const char* end) {
+    const char* newline = static_cast<const char*>(memchr(ptr, '\n', end - ptr));
+    return newline != nullptr ? newline + 1 : end;
+}
+
+inline const char* parseInt(const char* ptr, const char* end, long long& value) {
+    ptr = skipBlanks(ptr, end);
+    auto negative = false;
+    if (ptr < end && *ptr == '-') {
+        negative = true;
+        ptr++;
+    }
+    value = 0;
+    while (ptr < end && *ptr >= '0' && *ptr <= '9') {
+        value = value * 10 + (*ptr - '0');
+        ptr++;
+    }
+    if (negative) value = -value;
+    return ptr;
+}
+
+}
+
+VisitStamps& VisitStamps::local() {
+    static thread_local VisitStamps stamps;
+    return stamps;
+}
+
+Graph::Graph(int n) : numVertices(n), implicitDistance2(false), vertexOrder(VertexOrder::None),
+                      finalized(false), dynamic(false) {
+    adjOffsets.assign(n + 1, 0);
+    d2Offsets.assign(n + 1, 0);
+    bindOwnedArrays();
+}
+
+Graph::~Graph() {
+}
+
+void Graph::bindOwnedArrays() {
+    adjOffsetsData = adjOffsets.data();
+    adjIndicesData = adjIndices.data();
+    d2OffsetsData = d2Offsets.data();
+    d2IndicesData = d2Indices.data();
+    bindEnds();
+}
+
+void Graph::bindDistance2Arrays() {
+    d2OffsetsData = d2Offsets.data();
+    d2IndicesData = d2Indices.data();
+    bindEnds();
+}
+
+void Graph::bindEnds() {
+    if (dynamic) {
+        adjEndsData = adjLists.ends.data();
+        d2EndsData = d2Lists.ends.data();
+        return;
+    }
+    adjEndsData = adjOffsetsData != nullptr ? adjOffsetsData + 1 : nullptr;
+    d2EndsData = d2OffsetsData != nullptr ? d2OffsetsData + 1 : nullptr;
+}
+
+void Graph::bindDynamicArrays() {
+    adjOffsetsData = adjLists.starts.data();
+    adjIndicesData = adjLists.indices.data();
+    if (!implicitDistance2) {
+        d2OffsetsData = d2Lists.starts.data();
+        d2IndicesData = d2Lists.indices.data();
+    }
+    bindEnds();
+}
+
+void Graph::makeDynamic() {
+    if (dynamic) return;
+    
+    adjLists.assign(adjOffsetsData, adjIndicesData, numVertices);
+    if (!implicitDistance2) {
+        d2Lists.assign(d2OffsetsData, d2IndicesData, numVertices);
+    }
+    std::vector<std::size_t>().swap(adjOffsets);
+    std::vector<int>().swap(adjIndices);
+    std::vector<std::size_t>().swap(d2Offsets);
+    std::vector<int>().swap(d2Indices);
+    cacheMapping.reset();
+    
+    dynamic = true;
+    bindDynamicArrays();
+}
+
+void DynamicLists::assign(const std::size_t* offsets, const int* data, int n) {
+    starts.assign(offsets, offsets + n);
+    ends.assign(offsets + 1, offsets + n + 1);
+    limits = ends;
+    indices.assign(data, data + offsets[n]);
+    live = offsets[n] - offsets[0];
+}
+
+void DynamicLists::store(int v, const int* values, std::size_t count) {
+    live = live - (ends[v] - starts[v]) + count;
+    if (starts[v] + count > limits[v]) {
+        // Sem espaço: move a lista para o fim, com folga para crescer de novo
+        auto capacity = count + count / 2 + 4;
+        starts[v] = indices.size();
+        limits[v] = starts[v] + capacity;
+        indices.resize(limits[v]);
+    }
+    std::copy(values, values + count, indices.begin() + starts[v]);
+    ends[v] = starts[v] + count;
+    
+    if (indices.size() > 2 * live + 4096) compact();
 }
 
-void Graph::addEdge(int u, int v) {
+void DynamicLists::addList() {
+    starts.push_back(indices.size());
+    ends.push_back(indices.size());
+    limits.push_back(indices.size());
+}
+
+void DynamicLists::compact() {
+    std::vector<int> packed;
+    packed.reserve(live);
+    for (std::size_t v = 0; v < starts.size(); v++) {
+        auto start = packed.size();
+        packed.insert(packed.end(), indices.begin() + starts[v], indices.begin() + ends[v]);
+        starts[v] = start;
+        ends[v] = limits[v] = packed.size();
+    }
+    indices.swap(packed);
+}
+
+bool Graph::addEdge(int u, int v) {
     if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
         std::cerr << "Erro: vértices inválidos (" << u << ", " << v << ")" << std::endl;
-        return;
+        return false;
     }
     
-    // Evita duplicatas
-    if (std::find(adjList[u].begin(), adjList[u].end(), v) == adjList[u].end()) {
-        adjList[u].push_back(v);
+    // Laços não têm significado para L(p,q); duplicatas são removidas no CSR
+    if (u == v) return false;
+    if (!finalized) {
+        pendingEdges.push_back(std::make_pair(u, v));
+        return true;
     }
-    if (std::find(adjList[v].begin(), adjList[v].end(), u) == adjList[v].end()) {
-        adjList[v].push_back(u);
+    if (hasEdge(u, v)) return false;
+    
+    makeDynamic();
+    for (auto endpoint : {u, v}) {
+        auto other = endpoint == u ? v : u;
+        auto range = getNeighbors(endpoint);
+        std::vector<int> neighbors(range.begin(), range.end());
+        neighbors.insert(std::lower_bound(neighbors.begin(), neighbors.end(), other), other);
+        storeNeighbors(endpoint, neighbors);
     }
+    updateDistance2Around(u, v, true);
+    return true;
 }
 
-int Graph::getNumVertices() const {
-    return numVertices;
+bool Graph::removeEdge(int u, int v) {
+    if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
+        std::cerr << "Erro: vértices inválidos (" << u << ", " << v << ")" << std::endl;
+        return false;
+    }
+    if (!finalized || !hasEdge(u, v)) return false;
+    
+    makeDynamic();
+    for (auto endpoint : {u, v}) {
+        auto other = endpoint == u ? v : u;
+        auto range = getNeighbors(endpoint);
+        std::vector<int> neighbors(range.begin(), range.end());
+        neighbors.erase(std::lower_bound(neighbors.begin(), neighbors.end(), other));
+        storeNeighbors(endpoint, neighbors);
+    }
+    updateDistance2Around(u, v, false);
+    return true;
 }
 
-const std::vector<int>& Graph::getNeighbors(int v) const {
-    return adjList[v];
+int Graph::addVertex() {
+    if (finalized) {
+        makeDynamic();
+        adjLists.addList();
+        if (implicitDistance2) {
+            d2Degrees.push_back(0);
+        } else {
+            d2Lists.addList();
+        }
+        if (!originalIds.empty()) {
+            originalIds.push_back(numVertices);  // Sem correspondente no arquivo
+        }
+        bindDynamicArrays();
+    }
+    return numVertices++;
+}
+
+bool Graph::removeVertex(int v) {
+    if (v < 0 || v >= numVertices) {
+        std::cerr << "Erro: vértice inválido (" << v << ")" << std::endl;
+        return false;
+    }
+    auto range = getNeighbors(v);
+    std::vector<int> neighbors(range.begin(), range.end());
+    for (auto neighbor : neighbors) {
+        removeEdge(v, neighbor);
+    }
+    return true;
+}
+
+bool Graph::applyChange(const GraphChange& change) {
+    switch (change.type) {
+        case ChangeType::AddEdge: return addEdge(change.u, change.v);
+        case ChangeType::RemoveEdge: return removeEdge(change.u, change.v);
+        case ChangeType::AddVertex: addVertex(); return true;
+        case ChangeType::RemoveVertex: return removeVertex(change.u);
+    }
+    return false;
+}
+
+bool Graph::hasEdge(int u, int v) const {
+    if (!finalized) return false;
+    auto range = getNeighbors(u);
+    return std::binary_search(range.begin(), range.end(), v);
+}
+
+void Graph::storeNeighbors(int v, const std::vector<int>& neighbors) {
+    adjLists.store(v, neighbors.data(), neighbors.size());
+    bindDynamicArrays();
+}
+
+void Graph::updateDistance2Around(int u, int v, bool inserted) {
+    for (auto endpoint : {u, v}) {
+        auto other = endpoint == u ? v : u;
+        for (auto w : getNeighbors(endpoint)) {
+            if (w == other || hasEdge(other, w)) continue;
+            // Inserção: other passa a distância 2 de w se antes não havia
+            // vizinho comum além de endpoint. Remoção: sai se não restou nenhum.
+            if (inserted && !hasCommonNeighbor(other, w, endpoint)) {
+                setDistance2(w, other, true);
+            } else if (!inserted && !hasCommonNeighbor(other, w, -1)) {
+                setDistance2(w, other, false);
+            }
+        }
+    }
+    refreshDistance2(u);
+    refreshDistance2(v);
+    bindDynamicArrays();
+}
+
+void Graph::refreshDistance2(int v) {
+    std::vector<int> list;
+    VisitStamps& stamps = VisitStamps::local();
+    stamps.begin(numVertices);
+    stamps.visit(v);
+    for (auto neighbor : getNeighbors(v)) stamps.visit(neighbor);
+    for (auto neighbor : getNeighbors(v)) {
+        for (auto neighbor2 : getNeighbors(neighbor)) {
+            if (!stamps.visited(neighbor2)) {
+                stamps.visit(neighbor2);
+                list.push_back(neighbor2);
+            }
+        }
+    }
+    
+    if (implicitDistance2) {
+        d2Degrees[v] = static_cast<int>(list.size());
+        return;
+    }
+    std::sort(list.begin(), list.end());
+    d2Lists.store(v, list.data(), list.size());
+    bindDynamicArrays();
+}
+
+void Graph::setDistance2(int w, int x, bool present) {
+    if (implicitDistance2) {
+        d2Degrees[w] += present ? 1 : -1;
+        return;
+    }
+    auto range = getDistance2Neighbors(w);
+    std::vector<int> list(range.begin(), range.end());
+    auto position = std::lower_bound(list.begin(), list.end(), x);
+    if (present) {
+        list.insert(position, x);
+    } else {
+        list.erase(position);
+    }
+    d2Lists.store(w, list.data(), list.size());
+    bindDynamicArrays();
+}
+
+bool Graph::hasCommonNeighbor(int a, int b, int except) const {
+    auto first = getNeighbors(a), second = getNeighbors(b);
+    auto i = first.begin(), j = second.begin();
+    while (i != first.end() && j != second.end()) {
+        if (*i < *j) {
+            i++;
+        } else if (*j < *i) {
+            j++;
+        } else {
+            if (*i != except) return true;
+            i++;
+            j++;
+        }
+    }
+    return false;
+}
+
+bool Graph::finalize(const GraphOptions& options) {
+    finalized = true;
+    buildAdjacencyCSR();
+    if (options.vertexOrder != VertexOrder::None) {
+        reorderVertices(options.vertexOrder);
+    }
+    return computeDistance2Neighbors(options.numThreads, options.distance2MemoryLimit,
+                                     options.distance2Mode);
+}
+
+int Graph::getNumVertices() const {
+    return numVertices;
 }
 
-const std::set<int>& Graph::getDistance2Neighbors(int v) const {
-    return distance2Neighbors[v];
+int Graph::getDistance2Degree(int v) const {
+    if (implicitDistance2) return d2Degrees[v];
+    return static_cast<int>(d2EndsData[v] - d2OffsetsData[v]);
 }
 
 int Graph::getDegree(int v) const {
-    return adjList[v].size();
+    return static_cast<int>(adjEndsData[v] - adjOffsetsData[v]);
 }
 
-void Graph::computeDistance2Neighbors() {
-    // Para cada vértice, encontra vizinhos a distância 2
+void Graph::buildAdjacencyCSR() {
+    // Contagem dos graus (cada aresta aparece nas duas listas)
+    std::vector<std::size_t> counts(numVertices + 1, 0);
+    for (const auto& edge : pendingEdges) {
+        counts[edge.first + 1]++;
+        counts[edge.second + 1]++;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        counts[v + 1] += counts[v];
+    }
+    
+    std::vector<int> raw(counts[numVertices]);
+    std::vector<std::size_t> cursor(counts.begin(), counts.end() - 1);
+    for (const auto& edge : pendingEdges) {
+        raw[cursor[edge.first]++] = edge.second;
+        raw[cursor[edge.second]++] = edge.first;
+    }
+    std::vector<std::pair<int, int>>().swap(pendingEdges);
+    
+    // Ordena cada lista e remove duplicatas (sort + unique), compactando o CSR
+    adjOffsets.assign(numVertices + 1, 0);
+    adjIndices.clear();
+    adjIndices.reserve(raw.size());
     for (int v = 0; v < numVertices; v++) {
-        distance2Neighbors[v].clear();
+        auto first = raw.begin() + counts[v];
+        auto last = raw.begin() + counts[v + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        adjIndices.insert(adjIndices.end(), first, last);
+        adjOffsets[v + 1] = adjIndices.size();
+    }
+    adjIndices.shrink_to_fit();
+    
+    bindOwnedArrays();
+}
+
+std::vector<int> Graph::computeOrder(VertexOrder order) const {
+    std::vector<int> sequence(numVertices);
+    for (int v = 0; v < numVertices; v++) sequence[v] = v;
+    
+    auto byDegree = [this](int a, int b) { return getDegree(a) < getDegree(b); };
+    if (order == VertexOrder::Degree) {
+        std::stable_sort(sequence.begin(), sequence.end(), [this](int a, int b) {
+            return getDegree(a) > getDegree(b);
+        });
+        return sequence;
+    }
+    
+    // BFS/RCM: uma busca em largura por componente. No RCM cada componente
+    // parte de um vértice de grau mínimo e os vizinhos entram em ordem
+    // crescente de grau; a sequência final é invertida.
+    std::vector<int> roots;
+    roots.swap(sequence);
+    if (order == VertexOrder::RCM) {
+        std::stable_sort(roots.begin(), roots.end(), byDegree);
+    }
+    
+    sequence.reserve(numVertices);
+    std::vector<char> visited(numVertices, 0);
+    std::vector<int> discovered;
+    for (int root : roots) {
+        if (visited[root]) continue;
+        visited[root] = 1;
+        auto head = sequence.size();
+        sequence.push_back(root);
         
-        // Para cada vizinho direto
-        for (int neighbor : adjList[v]) {
-            // Para cada vizinho do vizinho
-            for (int neighbor2 : adjList[neighbor]) {
-                // Se não é o próprio vértice e não é vizinho direto
-                if (neighbor2 != v && 
-                    std::find(adjList[v].begin(), adjList[v].end(), neighbor2) == adjList[v].end()) {
-                    distance2Neighbors[v].insert(neighbor2);
+        while (head < sequence.size()) {
+            auto u = sequence[head++];
+            discovered.clear();
+            for (int neighbor : getNeighbors(u)) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = 1;
+                    discovered.push_back(neighbor);
                 }
             }
+            if (order == VertexOrder::RCM) {
+                std::stable_sort(discovered.begin(), discovered.end(), byDegree);
+            }
+            sequence.insert(sequence.end(), discovered.begin(), discovered.end());
+        }
+    }
+    
+    if (order == VertexOrder::RCM) {
+        std::reverse(sequence.begin(), sequence.end());
+    }
+    return sequence;
+}
+
+void Graph::reorderVertices(VertexOrder order) {
+    auto newToOld = computeOrder(order);
+    std::vector<int> oldToNew(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        oldToNew[newToOld[v]] = v;
+    }
+    
+    // Reescreve o CSR na nova numeração (listas continuam ordenadas)
+    std::vector<std::size_t> offsets(numVertices + 1, 0);
+    std::vector<int> indices(adjOffsetsData[numVertices]);
+    for (int v = 0; v < numVertices; v++) {
+        auto first = indices.begin() + offsets[v];
+        auto last = first;
+        for (int neighbor : getNeighbors(newToOld[v])) {
+            *last++ = oldToNew[neighbor];
         }
+        std::sort(first, last);
+        offsets[v + 1] = offsets[v] + (last - first);
     }
+    adjOffsets.swap(offsets);
+    adjIndices.swap(indices);
+    bindOwnedArrays();
+    
+    // Compõe com uma renumeração anterior, se houver
+    if (!originalIds.empty()) {
+        for (auto& id : newToOld) id = originalIds[id];
+    }
+    originalIds.swap(newToOld);
+    vertexOrder = order;
+}
+
+std::vector<int> Graph::toOriginalOrder(const std::vector<int>& values) const {
+    if (originalIds.empty()) return values;
+    
+    std::vector<int> result(values.size());
+    for (std::size_t v = 0; v < values.size(); v++) {
+        result[originalIds[v]] = values[v];
+    }
+    return result;
+}
+
+bool Graph::computeDistance2Neighbors(int numThreads, std::size_t memoryLimit, Distance2Mode mode) {
+    LPQ_TIME_SCOPE(&loadStats, Distance2);
+    const int chunkSize = 256;
+    auto numChunks = (numVertices + chunkSize - 1) / chunkSize;
+    auto threads = std::max(1, std::min(numThreads, numChunks));
+    
+    ThreadPool pool(threads);
+    std::vector<std::vector<int>> marks(threads);
+    
+    // Passo 1: conta os vizinhos a distância 2 de cada vértice
+    std::vector<std::size_t> counts(numVertices, 0);
+    pool.parallelFor(threads, [&](int t) {
+        marks[t].assign(numVertices, -1);
+        visitDistance2Chunks(*this, t, threads, chunkSize, marks[t],
+                             [&](int v, int) { counts[v]++; });
+    });
+    
+    d2Offsets.assign(numVertices + 1, 0);
+    for (int v = 0; v < numVertices; v++) {
+        d2Offsets[v + 1] = d2Offsets[v] + counts[v];
+    }
+    
+    auto total = d2Offsets[numVertices];
+    auto bytes = total * sizeof(int) + d2Offsets.size() * sizeof(std::size_t);
+    auto exceedsLimit = memoryLimit > 0 && bytes > memoryLimit;
+    
+    if (mode == Distance2Mode::Explicit && exceedsLimit) {
+        std::cerr << "Erro: vizinhança a distância 2 exige " << (bytes >> 20) << " MB "
+                  << "(limite: " << (memoryLimit >> 20) << " MB)" << std::endl;
+        d2Offsets.assign(numVertices + 1, 0);
+        bindDistance2Arrays();
+        return false;
+    }
+    
+    if (mode == Distance2Mode::Implicit || exceedsLimit) {
+        // Guarda apenas os graus; as listas são percorridas sob demanda
+        implicitDistance2 = true;
+        d2Degrees.assign(counts.begin(), counts.end());
+        std::vector<std::size_t>().swap(d2Offsets);
+        std::vector<int>().swap(d2Indices);
+        bindDistance2Arrays();
+        if (mode == Distance2Mode::Auto) {
+            std::cout << "Vizinhança a distância 2 exigiria " << (bytes >> 20)
+                      << " MB; usando modo implícito" << std::endl;
+        }
+        return true;
+    }
+    
+    implicitDistance2 = false;
+    
+    // Passo 2: escreve diretamente no array CSR e ordena cada lista
+    d2Indices.assign(total, 0);
+    bindDistance2Arrays();
+    pool.parallelFor(threads, [&](int t) {
+        std::fill(marks[t].begin(), marks[t].end(), -1);
+        visitDistance2Chunks(*this, t, threads, chunkSize, marks[t], [&](int v, int neighbor2) {
+            d2Indices[d2Offsets[v + 1] - counts[v]--] = neighbor2;
+        });
+        for (auto chunk = t; chunk < numChunks; chunk += threads) {
+            auto last = std::min(numVertices, (chunk + 1) * chunkSize);
+            for (auto v = chunk * chunkSize; v < last; v++) {
+                std::sort(d2Indices.begin() + d2Offsets[v], d2Indices.begin() + d2Offsets[v + 1]);
+            }
+        }
+    });
+    
+    return true;
 }
 
 void Graph::printGraph() const {
     std::cout << "Grafo com " << numVertices << " vértices:" << std::endl;
     for (int i = 0; i < numVertices; i++) {
         std::cout << "Vértice " << i << " -> ";
-        for (int neighbor : adjList[i]) {
+        for (int neighbor : getNeighbors(i)) {
             std::cout << neighbor << " ";
         }
         std::cout << std::endl;
     }
 }
 
-Graph* Graph::readFromFile(const std::string& filename) {
-    std::ifstream file(filename);
+Graph* Graph::loadCache(const std::string& cacheFile, const std::string& sourceFile,
+                        const GraphOptions& options) {
+    auto standalone = sourceFile.empty();
+    std::size_t sourceSize = 0;
+    long long sourceMtime = 0;
+    if (!standalone && !MappedFile::stat(sourceFile, sourceSize, sourceMtime)) return nullptr;
+    
+    std::unique_ptr<MappedFile> mapping(new MappedFile());
+    if (!mapping->open(cacheFile) || mapping->size() < sizeof(GraphCacheHeader)) {
+        return nullptr;
+    }
+    
+    GraphCacheHeader header;
+    memcpy(&header, mapping->data(), sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION) {
+        return nullptr;  // Inexistente ou de outra versão
+    }
+    if (!standalone && (header.sourceSize != sourceSize || header.sourceMtime != sourceMtime ||
+                        header.vertexOrder != static_cast<uint32_t>(options.vertexOrder))) {
+        return nullptr;  // Cache desatualizado ou com outra ordem
+    }
+    
+    // No arquivo avulso, a renumeração pedida é aplicada sobre o CSR lido
+    auto reorder = standalone && options.vertexOrder != VertexOrder::None;
+    
+    // Contagens absurdas estourariam os tamanhos calculados abaixo
+    if (header.numVertices > static_cast<uint64_t>(INT_MAX) ||
+        header.adjCount > mapping->size() / sizeof(int) || header.d2Count > mapping->size() / sizeof(int)) {
+        return nullptr;
+    }
+    
+    auto n = static_cast<std::size_t>(header.numVertices);
+    auto offsetsBytes = (n + 1) * sizeof(std::size_t);
+    auto permutationBytes = header.vertexOrder != 0 ? alignTo8(n * sizeof(int)) : 0;
+    auto expected = sizeof(GraphCacheHeader) + offsetsBytes + alignTo8(header.adjCount * sizeof(int)) +
+                    permutationBytes;
+    if (header.hasDistance2) {
+        expected += offsetsBytes + alignTo8(header.d2Count * sizeof(int));
+    }
+    if (mapping->size() != expected) return nullptr;
+    
+    // Valida os arrays antes de usá-los
+    const char* ptr = mapping->data() + sizeof(GraphCacheHeader);
+    auto adjIndices = ptr + offsetsBytes;
+    auto ids = adjIndices + alignTo8(header.adjCount * sizeof(int));
+    auto d2Offsets = ids + permutationBytes;
+    if (!validCSR(reinterpret_cast<const std::size_t*>(ptr), reinterpret_cast<const int*>(adjIndices),
+                  n, header.adjCount) ||
+        (permutationBytes > 0 && !validPermutation(reinterpret_cast<const int*>(ids), n)) ||
+        (header.hasDistance2 && !validCSR(reinterpret_cast<const std::size_t*>(d2Offsets),
+                                          reinterpret_cast<const int*>(d2Offsets + offsetsBytes),
+                                          n, header.d2Count))) {
+        return nullptr;
+    }
+    
+    // Os arrays do grafo apontam diretamente para o arquivo mapeado
+    Graph* graph = new Graph(static_cast<int>(n));
+    graph->adjOffsetsData = reinterpret_cast<const std::size_t*>(ptr);
+    ptr += offsetsBytes;
+    graph->adjIndicesData = reinterpret_cast<const int*>(ptr);
+    graph->bindEnds();
+    graph->finalized = true;
+    ptr += alignTo8(header.adjCount * sizeof(int));
+    
+    if (permutationBytes > 0) {
+        const int* ids = reinterpret_cast<const int*>(ptr);
+        graph->originalIds.assign(ids, ids + n);
+        graph->vertexOrder = static_cast<VertexOrder>(header.vertexOrder);
+        ptr += permutationBytes;
+    }
+    graph->adjOffsets.clear();
+    graph->cacheMapping = std::move(mapping);
+    
+    if (reorder) {
+        graph->reorderVertices(options.vertexOrder);
+    }
+    
+    if (header.hasDistance2 && !reorder && options.distance2Mode != Distance2Mode::Implicit) {
+        graph->d2OffsetsData = reinterpret_cast<const std::size_t*>(ptr);
+        ptr += offsetsBytes;
+        graph->d2IndicesData = reinterpret_cast<const int*>(ptr);
+        graph->d2Offsets.clear();
+        graph->bindEnds();
+    } else if (!graph->computeDistance2Neighbors(options.numThreads, options.distance2MemoryLimit,
+                                                 options.distance2Mode)) {
+        delete graph;
+        return nullptr;
+    }
+    
+    return graph;
+}
+
+bool Graph::saveCache(const std::string& cacheFile, const std::string& sourceFile) const {
+    std::size_t sourceSize = 0;
+    long long sourceMtime = 0;
+    if (!MappedFile::stat(sourceFile, sourceSize, sourceMtime)) return false;
+    
+    std::ofstream file(cacheFile, std::ios::binary | std::ios::trunc);
     if (!file.is_open()) {
+        std::cerr << "Erro ao criar cache: " << cacheFile << std::endl;
+        return false;
+    }
+    
+    GraphCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.hasDistance2 = implicitDistance2 ? 0 : 1;
+    header.vertexOrder = originalIds.empty() ? 0 : static_cast<uint32_t>(vertexOrder);
+    header.numVertices = numVertices;
+    header.adjCount = adjOffsetsData[numVertices];
+    header.d2Count = implicitDistance2 ? 0 : d2OffsetsData[numVertices];
+    header.sourceSize = sourceSize;
+    header.sourceMtime = sourceMtime;
+    
+    const char padding[8] = {0};
+    auto writeArray = [&](const void* data, std::size_t bytes) {
+        file.write(static_cast<const char*>(data), bytes);
+        file.write(padding, alignTo8(bytes) - bytes);
+    };
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeArray(adjOffsetsData, (numVertices + 1) * sizeof(std::size_t));
+    writeArray(adjIndicesData, header.adjCount * sizeof(int));
+    if (header.vertexOrder != 0) {
+        writeArray(originalIds.data(), numVertices * sizeof(int));
+    }
+    if (header.hasDistance2) {
+        writeArray(d2OffsetsData, (numVertices + 1) * sizeof(std::size_t));
+        writeArray(d2IndicesData, header.d2Count * sizeof(int));
+    }
+    
+    return static_cast<bool>(file);
+}
+
+Graph* Graph::readFromFile(const std::string& filename, const GraphOptions& options) {
+    LPQ_TIMER_START(loadTimer);
+    
+    if (!options.cacheFile.empty()) {
+        Graph* cached = loadCache(options.cacheFile, filename, options);
+        if (cached != nullptr) {
+            LPQ_TIMER_STOP(loadTimer, &cached->loadStats, Load);
+            std::cout << "Grafo carregado do cache: " << options.cacheFile << " ("
+                      << cached->getNumVertices() << " vértices)" << std::endl;
+            return cached;
+        }
+    }
+    
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Erro ao abrir arquivo: " << filename << std::endl;
         return nullptr;
     }
     
-    std::string line;
-    int numVertices = 0;
-    int numEdges = 0;
+    if (file.size() >= sizeof(CACHE_MAGIC) && memcmp(file.data(), CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0) {
+        file.close();
+        Graph* binary = loadCache(filename, "", options);
+        if (binary == nullptr) {
+            std::cerr << "Arquivo binário inválido ou de outra versão: " << filename << std::endl;
+            return nullptr;
+        }
+        LPQ_TIMER_STOP(loadTimer, &binary->loadStats, Load);
+        std::cout << "Grafo binário carregado: " << binary->getNumVertices() << " vértices" << std::endl;
+        return binary;
+    }
+    
+    const char* ptr = file.data();
+    const char* end = ptr + file.size();
     Graph* graph = nullptr;
     
-    while (std::getline(file, line)) {
-        // Ignora linhas vazias e comentários
-        if (line.empty() || line[0] == 'c') {
-            continue;
-        }
+    while (ptr < end) {
+        ptr = skipBlanks(ptr, end);
+        if (ptr >= end) break;
         
-        std::istringstream iss(line);
-        std::string type;
-        iss >> type;
-        
-        if (type == "p") {
+        if (*ptr == 'p') {
             // Linha de problema: p edge <numVertices> <numEdges>
-            std::string format;
-            iss >> format >> numVertices >> numEdges;
-            graph = new Graph(numVertices);
+            ptr = skipBlanks(ptr + 1, end);
+            while (ptr < end && *ptr != ' ' && *ptr != '\t' && *ptr != '\n') ptr++;
+            long long numVertices = 0, numEdges = 0;
+            ptr = parseInt(ptr, end, numVertices);
+            ptr = parseInt(ptr, end, numEdges);
+            delete graph;
+            graph = nullptr;
+            if (numVertices < 0 || numVertices > INT_MAX || numEdges < 0) {
+                std::cerr << "Linha 'p' inválida em " << filename << ": " << numVertices << " vértices, "
+                          << numEdges << " arestas" << std::endl;
+                return nullptr;
+            }
+            graph = new Graph(static_cast<int>(numVertices));
+            
+            // Cada linha "e u v" tem pelo menos 6 bytes: o cabeçalho não reserva além do arquivo
+            graph->pendingEdges.reserve(static_cast<std::size_t>(
+                std::min<long long>(numEdges, static_cast<long long>(file.size() / 6))));
             std::cout << "Lendo grafo: " << numVertices << " vértices, " 
                       << numEdges << " arestas" << std::endl;
         }
-        else if (type == "e" && graph != nullptr) {
+        else if (*ptr == 'e' && graph != nullptr) {
             // Linha de aresta: e <u> <v>
-            int u, v;
-            iss >> u >> v;
+            long long u = 0, v = 0;
+            ptr = parseInt(ptr + 1, end, u);
+            ptr = parseInt(ptr, end, v);
             // Formato DIMACS usa índices 1-based, convertemos para 0-based
-            graph->addEdge(u - 1, v - 1);
+            graph->addEdge(static_cast<int>(u - 1), static_cast<int>(v - 1));
         }
+        
+        // Ignora o restante da linha (comentários e linhas desconhecidas inteiras)
+        ptr = skipLine(ptr, end);
     }
     
     file.close();
     
     if (graph != nullptr) {
-        graph->computeDistance2Neighbors();
+        if (!graph->finalize(options)) {
+            delete graph;
+            return nullptr;
+        }
+        LPQ_TIMER_STOP(loadTimer, &graph->loadStats, Load);
         std::cout << "Grafo lido com sucesso!" << std::endl;
+        
+        if (!options.cacheFile.empty() && graph->saveCache(options.cacheFile, filename)) {
+            std::cout << "Cache do grafo salvo em: " << options.cacheFile << std::endl;
+        }
     }
     
     return graph;
 }
+
+long long Graph::writeBinary(const EdgeStream& edges, const std::string& filename,
+                            std::size_t memoryLimit) {
+    auto n = static_cast<std::size_t>(edges.numVertices());
+    
+    // Passada 1: graus -> offsets
+    std::vector<std::size_t> offsets(n + 1, 0);
+    edges.forEachEdge([&](int u, int v) {
+        offsets[u + 1]++;
+        offsets[v + 1]++;
+    });
+    for (std::size_t v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+    
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar arquivo: " << filename << std::endl;
+        return -1;
+    }
+    
+    GraphCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.numVertices = n;
+    header.adjCount = offsets[n];
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(offsets.data()), (n + 1) * sizeof(std::size_t));
+    
+    // Uma faixa [first, last) por vez, gravada em sequência. Com as arestas
+    // em ordem lexicográfica, cada lista recebe primeiro os vizinhos menores
+    // e depois os maiores, ambos em ordem crescente, sem precisar ordenar.
+    auto budget = std::max<std::size_t>(1, memoryLimit / sizeof(int));
+    std::vector<int> chunk;
+    std::vector<std::size_t> cursor;
+    for (std::size_t first = 0; first < n;) {
+        auto last = first + 1;
+        while (last < n && offsets[last + 1] - offsets[first] <= budget) last++;
+        
+        auto base = offsets[first];
+        chunk.assign(offsets[last] - base, 0);
+        cursor.assign(offsets.begin() + first, offsets.begin() + last);
+        edges.forEachEdge([&](int u, int v) {
+            auto uu = static_cast<std::size_t>(u), vv = static_cast<std::size_t>(v);
+            if (uu >= first && uu < last) chunk[cursor[uu - first]++ - base] = v;
+            if (vv >= first && vv < last) chunk[cursor[vv - first]++ - base] = u;
+        });
+        file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(int));
+        first = last;
+    }
+    
+    const char padding[8] = {0};
+    file.write(padding, alignTo8(header.adjCount * sizeof(int)) - header.adjCount * sizeof(int));
+    
+    if (!file) {
+        std::cerr << "Erro ao gravar arquivo: " << filename << std::endl;
+        return -1;
+    }
+    return static_cast<long long>(header.adjCount / 2);
+}
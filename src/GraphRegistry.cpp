@@ -0,0 +1,168 @@
+#include "../include/GraphRegistry.h"
+#include "../include/LowerBound.h"
+#include "../include/MappedFile.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+int RegisteredGraph::lowerBound(int p, int q) {
+    auto key = std::make_pair(p, q);
+    {
+        std::lock_guard<std::mutex> lock(boundsMutex);
+        auto it = lowerBounds.find(key);
+        if (it != lowerBounds.end()) return it->second;
+    }
+
+    // Calculado fora do lock; duas requisições simultâneas chegam ao mesmo valor
+    auto value = LowerBound::compute(graph.get(), p, q).value;
+    std::lock_guard<std::mutex> lock(boundsMutex);
+    lowerBounds[key] = value;
+    return value;
+}
+
+GraphRegistry::GraphRegistry(std::size_t capacity, const GraphOptions& options)
+    : capacity(capacity < 1 ? 1 : capacity), options(options), hits(0), misses(0), evictions(0) {
+    // Um cache binário único não serve a várias instâncias
+    this->options.cacheFile = "";
+}
+
+bool GraphRegistry::hashFile(const std::string& filename, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(filename)) return false;
+
+    hash = 1469598103934665603ULL;
+    auto data = reinterpret_cast<const unsigned char*>(file.data());
+    for (std::size_t i = 0; i < file.size(); i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return true;
+}
+
+void GraphRegistry::removeEntry(const std::string& instance, uint64_t hash) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->instance == instance && it->hash == hash) {
+            entries.erase(it);
+            return;
+        }
+    }
+}
+
+std::shared_ptr<RegisteredGraph> GraphRegistry::load(const std::string& instance, uint64_t hash,
+                                                     std::promise<std::shared_ptr<RegisteredGraph>>& promise) {
+    std::shared_ptr<RegisteredGraph> registered;
+    auto start = std::chrono::steady_clock::now();
+    Graph* graph = Graph::readFromFile(instance, options);
+    if (graph != nullptr) {
+        registered = std::make_shared<RegisteredGraph>();
+        registered->graph.reset(graph);
+        registered->instance = instance;
+        registered->contentHash = hash;
+        registered->loadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    promise.set_value(registered);
+    if (registered == nullptr) removeEntry(instance, hash);
+    return registered;
+}
+
+std::shared_ptr<RegisteredGraph> GraphRegistry::acquire(const std::string& instance, bool& cached) {
+    cached = false;
+    std::size_t size = 0;
+    long long mtime = 0;
+    if (!MappedFile::stat(instance, size, mtime)) {
+        std::cerr << "Erro ao abrir arquivo: " << instance << std::endl;
+        return nullptr;
+    }
+
+    std::shared_future<std::shared_ptr<RegisteredGraph>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->instance == instance && it->size == size && it->mtime == mtime) {
+                entries.splice(entries.begin(), entries, it);
+                pending = it->graph;
+                hits++;
+                break;
+            }
+        }
+    }
+
+    // Arquivo desconhecido ou modificado: o hash do conteúdo decide
+    uint64_t hash = 0;
+    if (!pending.valid()) {
+        if (!hashFile(instance, hash)) {
+            std::cerr << "Erro ao abrir arquivo: " << instance << std::endl;
+            return nullptr;
+        }
+
+        std::promise<std::shared_ptr<RegisteredGraph>> promise;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = entries.begin(); it != entries.end(); ) {
+                if (it->instance != instance) {
+                    ++it;
+                } else if (it->hash == hash) {
+                    // Mesmo conteúdo (arquivo apenas tocado ou lido por outra requisição)
+                    it->size = size;
+                    it->mtime = mtime;
+                    entries.splice(entries.begin(), entries, it);
+                    pending = it->graph;
+                    hits++;
+                    break;
+                } else {
+                    // Versão antiga do arquivo: nunca mais será pedida
+                    it = entries.erase(it);
+                }
+            }
+
+            if (!pending.valid()) {
+                Entry entry;
+                entry.instance = instance;
+                entry.size = size;
+                entry.mtime = mtime;
+                entry.hash = hash;
+                entry.graph = promise.get_future().share();
+                entries.push_front(entry);
+                misses++;
+                while (entries.size() > capacity) {
+                    entries.pop_back();
+                    evictions++;
+                }
+            }
+        }
+
+        if (!pending.valid()) return load(instance, hash, promise);
+    }
+
+    auto registered = pending.get();
+    cached = registered != nullptr;
+    return registered;
+}
+
+std::string GraphRegistry::statsJSON() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream json;
+    json << "\"capacity\":" << capacity << ",\"hits\":" << hits << ",\"misses\":" << misses
+         << ",\"evictions\":" << evictions << ",\"graphs\":[";
+    auto first = true;
+    for (const auto& entry : entries) {
+        // Leituras ainda em andamento não são listadas
+        if (entry.graph.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+        auto registered = entry.graph.get();
+        if (registered == nullptr) continue;
+
+        std::string escaped;
+        for (auto c : entry.instance) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        json << (first ? "" : ",") << "{\"instance\":\"" << escaped << "\",\"vertices\":"
+             << registered->graph->getNumVertices() << ",\"hash\":\"" << std::hex << entry.hash
+             << std::dec << "\",\"loadTime\":" << registered->loadTime << "}";
+        first = false;
+    }
+    json << "]";
+    return json.str();
+}
@@ -0,0 +1,58 @@
+#include "../include/IndexedMaxHeap.h"
+
+void IndexedMaxHeap::reset(int n) {
+    heap.clear();
+    heap.reserve(n);
+    position.assign(n, -1);
+    keys.assign(n, 0);
+}
+
+void IndexedMaxHeap::siftUp(std::size_t index) {
+    auto vertex = heap[index];
+    while (index > 0) {
+        auto parent = (index - 1) / 2;
+        if (!above(vertex, heap[parent])) break;
+        place(index, heap[parent]);
+        index = parent;
+    }
+    place(index, vertex);
+}
+
+void IndexedMaxHeap::siftDown(std::size_t index) {
+    auto vertex = heap[index];
+    auto count = heap.size();
+    while (true) {
+        auto child = 2 * index + 1;
+        if (child >= count) break;
+        if (child + 1 < count && above(heap[child + 1], heap[child])) child++;
+        if (!above(heap[child], vertex)) break;
+        place(index, heap[child]);
+        index = child;
+    }
+    place(index, vertex);
+}
+
+void IndexedMaxHeap::push(int vertex, long long key) {
+    keys[vertex] = key;
+    heap.push_back(vertex);
+    position[vertex] = static_cast<int>(heap.size()) - 1;
+    siftUp(heap.size() - 1);
+}
+
+void IndexedMaxHeap::increase(int vertex, long long key) {
+    if (key <= keys[vertex]) return;
+    keys[vertex] = key;
+    siftUp(position[vertex]);
+}
+
+int IndexedMaxHeap::pop() {
+    auto top = heap.front();
+    position[top] = -1;
+    auto last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        place(0, last);
+        siftDown(0);
+    }
+    return top;
+}
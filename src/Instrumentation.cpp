@@ -0,0 +1,54 @@
+#include "../include/Instrumentation.h"
+#include <sstream>
+#include <iomanip>
+
+Instrumentation::Instrumentation() {
+    for (auto i = 0; i < NumCounters; i++) counters[i] = 0;
+    for (auto i = 0; i < NumPhases; i++) phaseNanos[i] = 0;
+}
+
+void Instrumentation::merge(const Instrumentation& other) {
+    for (auto i = 0; i < NumCounters; i++) counters[i] += other.counters[i].load();
+    for (auto i = 0; i < NumPhases; i++) phaseNanos[i] += other.phaseNanos[i].load();
+}
+
+const char* Instrumentation::name(Counter counter) {
+    static const char* names[NumCounters] = {
+        "isValidColorCalls", "smallestColorQueries", "forbiddenRowUpdates", "constructions",
+        "costUpdates", "costUpdatesAvoided", "rclSelections", "rclSizeTotal",
+        "localSearchPasses", "localSearchMoves", "tabuIterations",
+        "relinkPaths", "relinkMoves", "exactNodes", "exactSteals"
+    };
+    return names[counter];
+}
+
+const char* Instrumentation::name(Phase phase) {
+    static const char* names[NumPhases] = {
+        "load", "distance2", "construction", "localSearch", "improvement", "validation",
+        "pathRelinking", "exact"
+    };
+    return names[phase];
+}
+
+bool Instrumentation::enabled() {
+#ifdef LPQ_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string Instrumentation::toJSON() const {
+    std::ostringstream json;
+    json << "{\"counters\": {";
+    for (auto i = 0; i < NumCounters; i++) {
+        json << (i > 0 ? ", " : "") << "\"" << name(static_cast<Counter>(i)) << "\": " << counters[i].load();
+    }
+    json << "}, \"phases\": {" << std::fixed << std::setprecision(6);
+    for (auto i = 0; i < NumPhases; i++) {
+        json << (i > 0 ? ", " : "") << "\"" << name(static_cast<Phase>(i)) << "\": "
+             << seconds(static_cast<Phase>(i));
+    }
+    json << "}}";
+    return json.str();
+}
@@ -1,104 +1,141 @@
 #include "../include/LPQColoring.h"
+#include "../include/ThreadPool.h"
+#include "../include/ConstructionWorkspace.h"
+#include "../include/ElitePool.h"
+#include "../include/IndexedMaxHeap.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <atomic>
 
 using namespace std;
 
-LPQColoring::LPQColoring(Graph* g, int p_val, int q_val, unsigned int seed) 
-    : graph(g), p(p_val), q(q_val), rng(seed) {
+namespace {
+
+// Path relinking: movimentos sorteados avaliados por passo, e fração inicial do
+// caminho (vizinhança da origem, já explorada pela busca local) não considerada
+const int relinkCandidates = 8;
+const int relinkSkipDivisor = 10;
+
+// Mantém em target o menor valor já oferecido
+void storeMin(atomic<int>& target, int value) {
+    auto current = target.load();
+    while (value < current && !target.compare_exchange_weak(current, value)) {
+    }
+}
+
+}
+
+LPQColoring::LPQColoring(Graph* g, int p_val, int q_val, unsigned int seed_val) 
+    : graph(g), p(p_val), q(q_val), kernels(&ConstraintKernels::select(p_val, q_val)),
+      seed(seed_val), numThreads(1), control(nullptr), lowerBound(-1),
+      instrumentation(nullptr), eliteSize(0) {
+}
+
+void LPQColoring::setNumThreads(int threads) {
+    numThreads = max(1, threads);
+}
+
+mt19937 LPQColoring::makeThreadRng(int threadIndex) const {
+    seed_seq sequence{seed, static_cast<unsigned int>(threadIndex)};
+    return mt19937(sequence);
 }
 
 bool LPQColoring::isValidColor(int vertex, int color, const vector<int>& coloring) const {
-    // Verifica restrição com vizinhos diretos (distância 1)
-    for (auto neighbor : graph->getNeighbors(vertex)) {
-        if (coloring[neighbor] != -1) {
-            auto diff = abs(color - coloring[neighbor]);
-            if (diff < p) {
-                return false;
-            }
-        }
-    }
-    
-    // Verifica restrição com vizinhos a distância 2
-    for (auto neighbor2 : graph->getDistance2Neighbors(vertex)) {
-        if (coloring[neighbor2] != -1) {
-            auto diff = abs(color - coloring[neighbor2]);
-            if (diff < q) {
-                return false;
-            }
-        }
-    }
-    
-    return true;
+    LPQ_COUNT(instrumentation, IsValidColorCalls, 1);
+    return kernels->isValidColor(*graph, p, q, vertex, color, coloring);
 }
 
-int LPQColoring::findSmallestValidColor(int vertex, const vector<int>& coloring) const {
-    auto color = 0;
-    while (!isValidColor(vertex, color, coloring)) {
-        color++;
-        if (color > 10000) {  // Proteção contra loop infinito
-            cerr << "Erro: não foi possível encontrar cor válida para vértice " << vertex << endl;
-            return color;
-        }
-    }
-    return color;
+int LPQColoring::smallestAllowed(int vertex, const ForbiddenColors& forbidden) const {
+    LPQ_COUNT(instrumentation, SmallestColorQueries, 1);
+    return forbidden.smallestAllowed(vertex);
 }
 
-vector<int> LPQColoring::getValidColors(int vertex, const vector<int>& coloring, int maxColorSoFar) const {
-    vector<int> validColors;
-    
-    // Testa cores de 0 até um pouco acima da maior cor atual
-    auto maxColorToTest = maxColorSoFar + max(p, q) + 10;
-    
-    for (auto color = 0; color <= maxColorToTest; color++) {
-        if (isValidColor(vertex, color, coloring)) {
-            validColors.push_back(color);
-        }
-    }
-    
-    return validColors;
+void LPQColoring::assignColor(int vertex, int color, Solution& sol, ForbiddenColors& forbidden) const {
+    sol.coloring[vertex] = color;
+    sol.maxColor = max(sol.maxColor, color);
+    
+    // Proíbe nos vizinhos não coloridos as cores a menos de p (distância 1) ou q (distância 2)
+    auto updated = kernels->forbidAround(*graph, p, q, vertex, color, sol.coloring, forbidden);
+    LPQ_COUNT(instrumentation, ForbiddenRowUpdates, updated);
+    (void)updated;
+}
+
+int LPQColoring::smallestValidColorBelow(int vertex, int limit, const vector<int>& coloring,
+                                         ForbiddenColors& scratch) const {
+    LPQ_COUNT(instrumentation, SmallestColorQueries, 1);
+    return kernels->smallestValidColorBelow(*graph, p, q, vertex, limit, coloring, scratch);
 }
 
-Solution LPQColoring::localSearch(Solution sol, int maxIterations) {
+void LPQColoring::localSearch(Solution& sol, int maxIterations, ConstructionWorkspace& workspace) const {
+    LPQ_TIME_SCOPE(instrumentation, LocalSearch);
     auto n = graph->getNumVertices();
+    if (n == 0) return;
+    
+    // Histograma de ocupação das cores e classes de cor com posição de cada vértice,
+    // para manter maxColor em O(1) amortizado e enumerar só a classe mais alta
+    auto& colorCount = workspace.colorCount;
+    auto& colorClasses = workspace.colorClasses;
+    auto& classPosition = workspace.classPosition;
+    colorCount.assign(sol.maxColor + 1, 0);
+    if (colorClasses.size() < colorCount.size()) colorClasses.resize(colorCount.size());
+    for (auto c = 0; c <= sol.maxColor; c++) colorClasses[c].clear();
+    classPosition.resize(n);
+    for (auto v = 0; v < n; v++) {
+        auto color = sol.coloring[v];
+        colorCount[color]++;
+        classPosition[v] = static_cast<int>(colorClasses[color].size());
+        colorClasses[color].push_back(v);
+    }
+    
+    auto& scratch = workspace.scratch;
+    auto& worklist = workspace.worklist;
     auto improved = true;
     auto iterations = 0;
     
     while (improved && iterations < maxIterations) {
+        if (iterations > 0 && timeExpired()) break;
+        if (sol.maxColor <= lowerBound) break;
         improved = false;
         iterations++;
+        LPQ_COUNT(instrumentation, LocalSearchPasses, 1);
+        
+        // Só esvaziar a classe do topo reduz maxColor: a passada tenta descer
+        // cada vértice dela (cópia, porque os movimentos alteram a classe); se
+        // ela esvaziar, a próxima passada trata a nova classe do topo
+        worklist.assign(colorClasses[sol.maxColor].begin(), colorClasses[sol.maxColor].end());
         
-        // Para cada vértice que usa uma cor alta, tenta recolori-lo com cor menor
-        for (auto v = 0; v < n; v++) {
+        auto maxColorBefore = sol.maxColor;
+        for (auto v : worklist) {
             auto currentColor = sol.coloring[v];
             
-            // Se não é um vértice com cor alta, skip
-            if (currentColor < sol.maxColor * 0.7) continue;
+            // Tenta a menor cor válida abaixo da atual
+            auto newColor = smallestValidColorBelow(v, currentColor, sol.coloring, scratch);
+            if (newColor >= currentColor) continue;
             
-            // Tenta cores menores
-            for (auto newColor = 0; newColor < currentColor; newColor++) {
-                if (isValidColor(v, newColor, sol.coloring)) {
-                    sol.coloring[v] = newColor;
-                    
-                    // Recalcula maxColor
-                    auto newMaxColor = 0;
-                    for (auto i = 0; i < n; i++) {
-                        newMaxColor = max(newMaxColor, sol.coloring[i]);
-                    }
-                    
-                    if (newMaxColor < sol.maxColor) {
-                        sol.maxColor = newMaxColor;
-                        improved = true;
-                    }
-                    break;
-                }
+            // Move v entre as classes (swap-and-pop na classe antiga)
+            auto& oldClass = colorClasses[currentColor];
+            auto last = oldClass.back();
+            oldClass[classPosition[v]] = last;
+            classPosition[last] = classPosition[v];
+            oldClass.pop_back();
+            classPosition[v] = static_cast<int>(colorClasses[newColor].size());
+            colorClasses[newColor].push_back(v);
+            
+            sol.coloring[v] = newColor;
+            LPQ_COUNT(instrumentation, LocalSearchMoves, 1);
+            colorCount[currentColor]--;
+            colorCount[newColor]++;
+            
+            // Maior cor só diminui: avança o topo enquanto a classe estiver vazia
+            while (sol.maxColor > 0 && colorCount[sol.maxColor] == 0) {
+                sol.maxColor--;
             }
         }
+        
+        improved = sol.maxColor < maxColorBefore;
     }
-    
-    return sol;
 }
 
 int LPQColoring::calculateSaturationDegree(int vertex, const vector<int>& coloring) const {
@@ -106,36 +143,45 @@ int LPQColoring::calculateSaturationDegree(int vertex, const vector<int>& colori
     for (auto neighbor : graph->getNeighbors(vertex)) {
         if (coloring[neighbor] != -1) satDegree++;
     }
-    for (auto neighbor2 : graph->getDistance2Neighbors(vertex)) {
+    graph->forEachDistance2Neighbor(vertex, [&](int neighbor2) {
         if (coloring[neighbor2] != -1) satDegree++;
-    }
+    });
     return satDegree;
 }
 
-double LPQColoring::calculateVertexCost(int vertex, const vector<int>& coloring) const {
-    auto minColor = findSmallestValidColor(vertex, coloring);
+int LPQColoring::calculateVertexCost(int vertex, const vector<int>& coloring,
+                                     const ForbiddenColors& forbidden) const {
+    auto minColor = smallestAllowed(vertex, forbidden);
     auto satDegree = calculateSaturationDegree(vertex, coloring);
-    return minColor * 100.0 - satDegree;
+    return minColor * 100 - satDegree;
 }
 
-int LPQColoring::selectVertexFromRCL(const vector<pair<double, int>>& costs, double alpha) {
+int LPQColoring::selectVertexFromRCL(const vector<pair<int, int>>& costs, double alpha,
+                                     mt19937& rng) const {
     auto minCost = costs[0].first;
     auto maxCost = costs.back().first;
     auto threshold = minCost + alpha * (maxCost - minCost);
     
-    vector<int> rcl;
-    rcl.reserve(costs.size() / 4); // Otimização: reserva memória
-    
-    for (const auto& pair : costs) {
-        if (pair.first <= threshold) {
-            rcl.push_back(pair.second);
-        } else {
-            break; // Já está ordenado, pode parar
-        }
+    // Como costs está ordenado, a RCL é o prefixo com custo <= threshold
+    size_t rclSize = 0;
+    while (rclSize < costs.size() && costs[rclSize].first <= threshold) {
+        rclSize++;
     }
     
-    uniform_int_distribution<int> dist(0, rcl.size() - 1);
-    return rcl[dist(rng)];
+    LPQ_COUNT(instrumentation, RclSelections, 1);
+    LPQ_COUNT(instrumentation, RclSizeTotal, rclSize);
+    uniform_int_distribution<int> dist(0, rclSize - 1);
+    return costs[dist(rng)].second;
+}
+
+int LPQColoring::selectVertexFromRCL(const CostBuckets& queue, double alpha, mt19937& rng) const {
+    auto minCost = queue.minCost();
+    auto maxCost = queue.maxCost();
+    auto threshold = minCost + alpha * (maxCost - minCost);
+    
+    LPQ_COUNT(instrumentation, RclSelections, 1);
+    LPQ_COUNT(instrumentation, RclSizeTotal, queue.countUpTo(threshold));
+    return queue.selectUpTo(threshold, rng);
 }
 
 void LPQColoring::updateProbabilities(vector<double>& probabilities,
@@ -164,37 +210,37 @@ void LPQColoring::updateProbabilities(vector<double>& probabilities,
     }
 }
 
-Solution LPQColoring::buildSolution(double alpha) {
+void LPQColoring::buildSolution(double alpha, mt19937& rng, ConstructionWorkspace& workspace) const {
+    LPQ_TIME_SCOPE(instrumentation, Construction);
+    LPQ_COUNT(instrumentation, Constructions, 1);
     auto n = graph->getNumVertices();
-    Solution sol(n);
+    workspace.reset(n);
+    auto& sol = workspace.solution;
+    auto& forbidden = workspace.forbidden;
     
     // Usa vetor de índices e swap-and-pop para remoção O(1)
-    vector<int> uncolored(n);
+    auto& uncolored = workspace.uncolored;
+    uncolored.resize(n);
     iota(uncolored.begin(), uncolored.end(), 0);
     
-    // Array de flags para acesso rápido
-    vector<bool> isColored(n, false);
-    
+    auto& costs = workspace.costs;
     while (!uncolored.empty()) {
-        vector<pair<double, int>> costs;
-        costs.reserve(uncolored.size());
+        costs.clear();
         
         // Calcula custos para todos os vértices não coloridos
+        LPQ_COUNT(instrumentation, CostUpdates, uncolored.size());
         for (auto v : uncolored) {
-            costs.push_back({calculateVertexCost(v, sol.coloring), v});
+            costs.push_back({calculateVertexCost(v, sol.coloring, forbidden), v});
         }
         
         // Ordena por custo (menor custo = melhor candidato)
         sort(costs.begin(), costs.end());
         
         // Seleciona vértice da RCL
-        auto chosenVertex = selectVertexFromRCL(costs, alpha);
+        auto chosenVertex = selectVertexFromRCL(costs, alpha, rng);
         
         // Colore o vértice escolhido
-        auto color = findSmallestValidColor(chosenVertex, sol.coloring);
-        sol.coloring[chosenVertex] = color;
-        sol.maxColor = max(sol.maxColor, color);
-        isColored[chosenVertex] = true;
+        assignColor(chosenVertex, smallestAllowed(chosenVertex, forbidden), sol, forbidden);
         
         // Remove vértice colorido usando swap-and-pop O(1)
         for (size_t i = 0; i < uncolored.size(); i++) {
@@ -205,75 +251,61 @@ Solution LPQColoring::buildSolution(double alpha) {
             }
         }
     }
-    
-    return sol;
 }
 
-Solution LPQColoring::buildSolutionIncremental(double alpha) {
+void LPQColoring::buildSolutionIncremental(double alpha, mt19937& rng, ConstructionWorkspace& workspace) const {
+    LPQ_TIME_SCOPE(instrumentation, Construction);
+    LPQ_COUNT(instrumentation, Constructions, 1);
     auto n = graph->getNumVertices();
-    Solution sol(n);
+    workspace.reset(n);
+    auto& sol = workspace.solution;
+    auto& forbidden = workspace.forbidden;
     
-    // Estruturas para otimização incremental
-    vector<int> uncolored(n);
-    iota(uncolored.begin(), uncolored.end(), 0);
+    // Fila indexada pelos custos; contém exatamente os vértices não coloridos
+    auto& queue = workspace.queue;
     
-    vector<bool> isColored(n, false);
-    vector<bool> needsUpdate(n, true);  // Marca vértices que precisam recalcular custo
-    vector<double> cachedCosts(n, 0.0);
+    // Grau de saturação mantido incrementalmente (mesmo valor de calculateSaturationDegree);
+    // volta a zero quando o vértice é colorido, deixando o vetor limpo para a próxima construção
+    auto& saturation = workspace.saturation;
     
-    // Calcula custos iniciais
-    for (auto v : uncolored) {
-        cachedCosts[v] = calculateVertexCost(v, sol.coloring);
+    // Custos iniciais: sem vértices coloridos, todos valem 0
+    for (auto v = 0; v < n; v++) {
+        queue.update(v, 0);
     }
     
-    while (!uncolored.empty()) {
-        vector<pair<double, int>> costs;
-        costs.reserve(uncolored.size());
-        
-        // Usa custos em cache ou recalcula se necessário
-        for (auto v : uncolored) {
-            if (needsUpdate[v]) {
-                cachedCosts[v] = calculateVertexCost(v, sol.coloring);
-                needsUpdate[v] = false;
-            }
-            costs.push_back({cachedCosts[v], v});
-        }
-        
-        sort(costs.begin(), costs.end());
-        auto chosenVertex = selectVertexFromRCL(costs, alpha);
+    while (!queue.empty()) {
+        auto chosenVertex = selectVertexFromRCL(queue, alpha, rng);
         
         // Colore o vértice
-        auto color = findSmallestValidColor(chosenVertex, sol.coloring);
-        sol.coloring[chosenVertex] = color;
-        sol.maxColor = max(sol.maxColor, color);
-        isColored[chosenVertex] = true;
+        assignColor(chosenVertex, smallestAllowed(chosenVertex, forbidden), sol, forbidden);
+        queue.remove(chosenVertex);
+        saturation[chosenVertex] = 0;
         
-        // Marca vizinhos para atualização (afetados pela coloração)
+        // Apenas os vizinhos afetados pela coloração têm o custo recalculado
+        // (evitados = não coloridos restantes - recalculados)
+        LPQ_COUNT(instrumentation, CostUpdatesAvoided, queue.size());
         for (auto neighbor : graph->getNeighbors(chosenVertex)) {
-            if (!isColored[neighbor]) {
-                needsUpdate[neighbor] = true;
-            }
-        }
-        for (auto neighbor2 : graph->getDistance2Neighbors(chosenVertex)) {
-            if (!isColored[neighbor2]) {
-                needsUpdate[neighbor2] = true;
+            if (sol.coloring[neighbor] == -1) {
+                LPQ_COUNT(instrumentation, CostUpdates, 1);
+                LPQ_COUNT(instrumentation, CostUpdatesAvoided, -1);
+                saturation[neighbor]++;
+                queue.update(neighbor, smallestAllowed(neighbor, forbidden) * 100 - saturation[neighbor]);
             }
         }
-        
-        // Remove usando swap-and-pop
-        for (size_t i = 0; i < uncolored.size(); i++) {
-            if (uncolored[i] == chosenVertex) {
-                uncolored[i] = uncolored.back();
-                uncolored.pop_back();
-                break;
+        graph->forEachDistance2Neighbor(chosenVertex, [&](int neighbor2) {
+            if (sol.coloring[neighbor2] == -1) {
+                LPQ_COUNT(instrumentation, CostUpdates, 1);
+                LPQ_COUNT(instrumentation, CostUpdatesAvoided, -1);
+                saturation[neighbor2]++;
+                queue.update(neighbor2, smallestAllowed(neighbor2, forbidden) * 100 - saturation[neighbor2]);
             }
-        }
+        });
     }
-    
-    return sol;
 }
 
 Solution LPQColoring::greedy() {
+    LPQ_TIME_SCOPE(instrumentation, Construction);
+    LPQ_COUNT(instrumentation, Constructions, 1);
     auto n = graph->getNumVertices();
     Solution sol(n);
     
@@ -283,122 +315,520 @@ Solution LPQColoring::greedy() {
     
     // Ordena inicialmente por grau decrescente
     sort(vertices.begin(), vertices.end(), [this](int a, int b) {
-        auto degreeA = graph->getDegree(a) + graph->getDistance2Neighbors(a).size();
-        auto degreeB = graph->getDegree(b) + graph->getDistance2Neighbors(b).size();
+        auto degreeA = graph->getDegree(a) + graph->getDistance2Degree(a);
+        auto degreeB = graph->getDegree(b) + graph->getDistance2Degree(b);
         return degreeA > degreeB;
     });
     
+    ForbiddenColors forbidden;
+    forbidden.reset(n);
+    
     // Colore cada vértice com a menor cor válida
     for (auto v : vertices) {
-        auto color = findSmallestValidColor(v, sol.coloring);
-        sol.coloring[v] = color;
-        sol.maxColor = max(sol.maxColor, color);
+        assignColor(v, smallestAllowed(v, forbidden), sol, forbidden);
     }
     
+    if (control != nullptr) control->report(0, sol.maxColor, "greedy");
+    
     return sol;
 }
 
-Solution LPQColoring::greedyRandomized(double alpha, int iterations) {
+bool LPQColoring::pathRelinking(const Solution& from, const Solution& guide, mt19937& rng,
+                                ConstructionWorkspace& workspace) const {
+    LPQ_TIME_SCOPE(instrumentation, PathRelinking);
+    LPQ_COUNT(instrumentation, RelinkPaths, 1);
     auto n = graph->getNumVertices();
-    Solution bestSol(n);
-    bestSol.maxColor = INT32_MAX;
+    workspace.reset(n);
+    auto& current = workspace.solution;
+    current.coloring = from.coloring;
+    current.maxColor = from.maxColor;
     
-    for (auto iter = 0; iter < iterations; iter++) {
-        auto sol = buildSolution(alpha);
+    auto& differences = workspace.differences;
+    differences.clear();
+    for (auto v = 0; v < n; v++) {
+        if (from.coloring[v] != guide.coloring[v]) differences.push_back(v);
+    }
+    if (differences.size() < 2) return false;
+    
+    // Histograma das cores do caminho, para manter a maior cor a cada passo
+    auto& colorCount = workspace.colorCount;
+    colorCount.assign(max(from.maxColor, guide.maxColor) + 1, 0);
+    for (auto v = 0; v < n; v++) colorCount[current.coloring[v]]++;
+    auto setColor = [&](int v, int color) {
+        if (color >= static_cast<int>(colorCount.size())) colorCount.resize(color + 1, 0);
+        current.coloring[v] = color;
+        colorCount[color]++;
+        current.maxColor = max(current.maxColor, color);
+    };
+    auto clearColor = [&](int v) {
+        colorCount[current.coloring[v]]--;
+        current.coloring[v] = -1;
+    };
+    
+    auto& best = workspace.relinkBest;
+    best.maxColor = INT32_MAX;
+    auto& displaced = workspace.displaced;
+    auto reach = max(p, q);
+    
+    // Vizinhos que a cor do guia deslocaria de v
+    auto moveConflicts = [&](int v) {
+        auto target = guide.coloring[v];
+        auto conflicts = 0;
+        for (auto neighbor : graph->getNeighbors(v)) {
+            auto c = current.coloring[neighbor];
+            if (c != -1 && abs(c - target) < p) conflicts++;
+        }
+        graph->forEachDistance2Neighbor(v, [&](int neighbor2) {
+            auto c = current.coloring[neighbor2];
+            if (c != -1 && abs(c - target) < q) conflicts++;
+        });
+        return conflicts;
+    };
+    
+    // Melhor intermediária: menor maior cor e, no empate, menos vértices nela
+    // (mais perto de a busca local esvaziar a classe)
+    auto bestTop = INT32_MAX;
+    auto total = differences.size();
+    
+    // O último passo chegaria ao próprio guia: só os intermediários contam
+    for (size_t step = 0; step + 1 < total; step++) {
+        if ((step & 63) == 63 && timeExpired()) break;
         
-        // Atualiza melhor solução
-        if (sol.maxColor < bestSol.maxColor) {
-            bestSol = sol;
+        // Entre alguns vértices restantes sorteados, move o que desloca menos
+        // vizinhos; os que já têm a cor do guia são só descartados
+        auto chosen = step;
+        auto chosenConflicts = INT32_MAX;
+        uniform_int_distribution<size_t> pick(step, total - 1);
+        for (auto k = 0; k < relinkCandidates && chosenConflicts > 0; k++) {
+            auto j = pick(rng);
+            auto u = differences[j];
+            auto conflicts = current.coloring[u] == guide.coloring[u] ? -1 : moveConflicts(u);
+            if (conflicts < chosenConflicts) {
+                chosen = j;
+                chosenConflicts = conflicts;
+            }
         }
+        swap(differences[step], differences[chosen]);
+        auto v = differences[step];
+        if (chosenConflicts < 0) continue;
+        LPQ_COUNT(instrumentation, RelinkMoves, 1);
+        
+        // Vértices que já têm a cor do guia nunca conflitam com ela: só os
+        // demais podem ser deslocados
+        auto target = guide.coloring[v];
+        clearColor(v);
+        setColor(v, target);
+        displaced.clear();
+        for (auto neighbor : graph->getNeighbors(v)) {
+            auto c = current.coloring[neighbor];
+            if (c != -1 && abs(c - target) < p) {
+                clearColor(neighbor);
+                displaced.push_back(neighbor);
+            }
+        }
+        graph->forEachDistance2Neighbor(v, [&](int neighbor2) {
+            auto c = current.coloring[neighbor2];
+            if (c != -1 && abs(c - target) < q) {
+                clearColor(neighbor2);
+                displaced.push_back(neighbor2);
+            }
+        });
+        
+        // Reparo incremental: menor cor válida para cada deslocado (acima da
+        // maior cor + max(p,q) sempre há uma)
+        for (auto u : displaced) {
+            setColor(u, smallestValidColorBelow(u, current.maxColor + reach + 1, current.coloring,
+                                                workspace.scratch));
+        }
+        while (current.maxColor > 0 && colorCount[current.maxColor] == 0) {
+            current.maxColor--;
+        }
+        
+        auto top = colorCount[current.maxColor];
+        if (step >= total / relinkSkipDivisor &&
+            (current.maxColor < best.maxColor || (current.maxColor == best.maxColor && top < bestTop))) {
+            best.coloring = current.coloring;
+            best.maxColor = current.maxColor;
+            bestTop = top;
+        }
+    }
+    if (best.maxColor == INT32_MAX) return false;
+    
+    swap(current, best);
+    localSearch(current, 100, workspace);
+    return true;
+}
+
+Solution LPQColoring::dsatur() {
+    LPQ_TIME_SCOPE(instrumentation, Construction);
+    LPQ_COUNT(instrumentation, Constructions, 1);
+    auto n = graph->getNumVertices();
+    Solution sol(n);
+    
+    ForbiddenColors forbidden;
+    forbidden.reset(n);
+    vector<int> forbiddenCount(n, 0);  // Cores proibidas (grau de saturação)
+    vector<int> smallest(n, 0);        // Menor cor viável
+    
+    // Chave do heap: cores proibidas e, no empate, grau em G e G²
+    vector<long long> degree(n);
+    long long maxDegree = 0;
+    for (auto v = 0; v < n; v++) {
+        degree[v] = graph->getDegree(v) + graph->getDistance2Degree(v);
+        maxDegree = max(maxDegree, degree[v]);
+    }
+    IndexedMaxHeap heap;
+    heap.reset(n);
+    for (auto v = 0; v < n; v++) {
+        heap.push(v, degree[v]);
+    }
+    
+    // Proíbe [lo, hi] em u; só as cores novas mudam a chave, e a menor cor
+    // viável só é procurada de novo se caiu no intervalo
+    auto forbid = [&](int u, int lo, int hi) {
+        auto added = lo == hi ? forbidden.forbidColor(u, lo) : forbidden.forbidRange(u, lo, hi);
+        LPQ_COUNT(instrumentation, CostUpdates, 1);
+        if (added == 0) return;
+        forbiddenCount[u] += added;
+        if (smallest[u] >= lo && smallest[u] <= hi) {
+            LPQ_COUNT(instrumentation, SmallestColorQueries, 1);
+            smallest[u] = forbidden.smallestAllowedFrom(u, hi + 1);
+        }
+        heap.increase(u, forbiddenCount[u] * (maxDegree + 1) + degree[u]);
+    };
+    
+    while (!heap.empty()) {
+        auto v = heap.pop();
+        auto color = smallest[v];
+        sol.coloring[v] = color;
+        sol.maxColor = max(sol.maxColor, color);
+        
+        for (auto neighbor : graph->getNeighbors(v)) {
+            if (sol.coloring[neighbor] == -1 && p > 0) forbid(neighbor, max(0, color - p + 1), color + p - 1);
+        }
+        graph->forEachDistance2Neighbor(v, [&](int neighbor2) {
+            if (sol.coloring[neighbor2] == -1 && q > 0) forbid(neighbor2, max(0, color - q + 1), color + q - 1);
+        });
     }
     
-    // Aplica busca local na melhor solução
-    bestSol = localSearch(bestSol, 50);
+    if (control != nullptr) control->report(0, sol.maxColor, "dsatur");
     
-    return bestSol;
+    return sol;
+}
+
+Solution LPQColoring::mergeThreadBest(vector<Solution>& threadBest, const vector<int>& threadBestIter) const {
+    // Menor maxColor vence; empate fica com a menor iteração, independente do escalonamento
+    size_t best = 0;
+    for (size_t t = 1; t < threadBest.size(); t++) {
+        if (threadBest[t].maxColor < threadBest[best].maxColor ||
+            (threadBest[t].maxColor == threadBest[best].maxColor &&
+             threadBestIter[t] < threadBestIter[best])) {
+            best = t;
+        }
+    }
+    return std::move(threadBest[best]);
+}
+
+bool LPQColoring::seedThreadBest(vector<Solution>& threadBest, vector<int>& threadBestIter,
+                                 atomic<int>& boundHitIter) const {
+    if (initial.coloring.size() != static_cast<size_t>(graph->getNumVertices())) return false;
+    threadBest[0] = initial;
+    threadBestIter[0] = -1;
+    if (initial.maxColor <= lowerBound) boundHitIter = -1;
+    return true;
+}
+
+Solution LPQColoring::greedyRandomized(double alpha, int iterations) {
+    auto n = graph->getNumVertices();
+    
+    // Cada thread lógica t executa as iterações t, t+T, t+2T, ... com seu próprio
+    // gerador, então o resultado depende apenas de (semente, threads)
+    auto threads = max(1, min(numThreads, iterations));
+    vector<Solution> threadBest(threads, Solution(n));
+    vector<int> threadBestIter(threads, INT32_MAX);
+    for (auto& sol : threadBest) sol.maxColor = INT32_MAX;
+    
+    // Menor iteração que atingiu o limite inferior. As threads só descartam
+    // iterações posteriores a ela, então o desempate continua determinístico.
+    atomic<int> boundHitIter(INT32_MAX);
+    seedThreadBest(threadBest, threadBestIter, boundHitIter);
+    
+    ThreadPool pool(threads);
+    pool.parallelFor(threads, [&](int t) {
+        auto rng = makeThreadRng(t);
+        ConstructionWorkspace workspace(n);
+        auto& sol = workspace.solution;
+        for (auto iter = t; iter < iterations; iter += threads) {
+            // A primeira iteração sempre roda, garantindo uma solução válida
+            if (iter > 0 && timeExpired()) break;
+            if (iter > boundHitIter) break;
+            
+            // Constrói a solução. Sem busca local: cada vértice recebe a menor
+            // cor válida diante dos já coloridos, então nenhum pode descer depois
+            buildSolution(alpha, rng, workspace);
+            if (sol.maxColor <= lowerBound) storeMin(boundHitIter, iter);
+            
+            // Atualiza melhor solução da thread (troca de buffers, sem cópia)
+            if (sol.maxColor < threadBest[t].maxColor) {
+                if (control != nullptr) control->report(iter, sol.maxColor, "construction");
+                swap(sol, threadBest[t]);
+                threadBestIter[t] = iter;
+            }
+        }
+    });
+    
+    return mergeThreadBest(threadBest, threadBestIter);
 }
 
 Solution LPQColoring::greedyRandomizedReactive(const vector<double>& alphas, int iterations, int blockSize) {
     auto n = graph->getNumVertices();
-    Solution bestSol(n);
-    bestSol.maxColor = INT32_MAX;
     
     auto numAlphas = alphas.size();
     vector<double> probabilities(numAlphas, 1.0 / numAlphas);
-    vector<double> blockQuality(numAlphas, 0.0);
-    vector<size_t> blockUsage(numAlphas, 0);
     
-    auto iterationsInBlock = 0;
+    // Estado por thread lógica: gerador, melhor solução e estatísticas do bloco
+    auto threads = max(1, min(numThreads, iterations));
+    vector<mt19937> rngs;
+    for (auto t = 0; t < threads; t++) {
+        rngs.push_back(makeThreadRng(t));
+    }
+    vector<Solution> threadBest(threads, Solution(n));
+    vector<int> threadBestIter(threads, INT32_MAX);
+    for (auto& sol : threadBest) sol.maxColor = INT32_MAX;
+    vector<vector<double>> blockQuality(threads, vector<double>(numAlphas, 0.0));
+    vector<vector<size_t>> blockUsage(threads, vector<size_t>(numAlphas, 0));
+    vector<ConstructionWorkspace> workspaces(threads);
+    
+    // Pools elite por thread (iterações fixas por thread mantêm o determinismo)
+    auto minDistance = max(1, n / 100);
+    vector<ElitePool> elite(threads, ElitePool(eliteSize, minDistance));
+    
+    ThreadPool pool(threads);
+    blockSize = max(1, blockSize);
+    atomic<int> boundHitIter(INT32_MAX);  // Ver greedyRandomized
+    if (seedThreadBest(threadBest, threadBestIter, boundHitIter) && eliteSize > 0) {
+        elite[0].offer(threadBest[0], -1);
+    }
     
-    for (auto iter = 0; iter < iterations; iter++) {
-        // Seleciona alpha baseado nas probabilidades
-        discrete_distribution<int> dist(probabilities.begin(), probabilities.end());
-        auto alphaIndex = dist(rng);
+    // Oferece a solução de workspace ao pool elite e à melhor da thread
+    auto record = [&](int t, int iter, const char* phase) {
+        auto& sol = workspaces[t].solution;
+        if (sol.maxColor <= lowerBound) storeMin(boundHitIter, iter);
+        if (eliteSize > 0) elite[t].offer(sol, iter);
         
-        // Constrói solução usando o alpha selecionado (versão incremental)
-        auto sol = buildSolutionIncremental(alphas[alphaIndex]);
+        // Troca de buffers, sem cópia
+        if (sol.maxColor < threadBest[t].maxColor) {
+            if (control != nullptr) control->report(iter, sol.maxColor, phase);
+            swap(sol, threadBest[t]);
+            threadBestIter[t] = iter;
+        }
+    };
+    
+    // Processa um bloco por vez; as probabilidades ficam fixas dentro do bloco
+    for (auto blockStart = 0; blockStart < iterations; blockStart += blockSize) {
+        if (blockStart > 0 && timeExpired()) break;
+        auto blockEnd = min(iterations, blockStart + blockSize);
         
-        // Atualiza estatísticas do bloco
-        auto quality = 1.0 / (1.0 + sol.maxColor);
-        blockQuality[alphaIndex] += quality;
-        blockUsage[alphaIndex]++;
-        iterationsInBlock++;
+        pool.parallelFor(threads, [&](int t) {
+            auto& rng = rngs[t];
+            auto& workspace = workspaces[t];
+            auto& sol = workspace.solution;
+            discrete_distribution<int> dist(probabilities.begin(), probabilities.end());
+            auto lastIter = -1;
+            
+            for (auto iter = blockStart + t; iter < blockEnd; iter += threads) {
+                if (iter > 0 && timeExpired()) break;
+                if (iter > boundHitIter) break;
+                
+                // Seleciona alpha baseado nas probabilidades
+                auto alphaIndex = dist(rng);
+                
+                // Constrói solução usando o alpha selecionado (versão incremental;
+                // sem busca local, ver greedyRandomized)
+                buildSolutionIncremental(alphas[alphaIndex], rng, workspace);
+                
+                // Atualiza estatísticas do bloco
+                blockQuality[t][alphaIndex] += 1.0 / (1.0 + sol.maxColor);
+                blockUsage[t][alphaIndex]++;
+                
+                record(t, iter, "construction");
+                lastIter = iter;
+            }
+            
+            // Path relinking periódico: da melhor solução do pool da thread até
+            // outra sorteada do pool (contado como a última iteração da thread)
+            if (eliteSize > 0 && elite[t].size() >= 2 && lastIter >= 0 &&
+                lastIter <= boundHitIter && !timeExpired()) {
+                auto from = elite[t].best();
+                uniform_int_distribution<size_t> pick(0, elite[t].size() - 2);
+                auto guide = pick(rng);
+                if (guide >= from) guide++;
+                if (pathRelinking(elite[t][from], elite[t][guide], rng, workspace)) {
+                    record(t, lastIter, "relinking");
+                }
+            }
+        });
         
-        // Atualiza melhor solução
-        if (sol.maxColor < bestSol.maxColor) {
-            bestSol = sol;
-        }
+        // Solução ótima encontrada: não há o que melhorar nos próximos blocos
+        if (boundHitIter != INT32_MAX) break;
         
-        // Atualiza probabilidades ao final de cada bloco
-        if (iterationsInBlock >= blockSize) {
-            updateProbabilities(probabilities, blockQuality, blockUsage);
+        // Agrega as estatísticas das threads (em ordem fixa) ao final do bloco
+        if (blockEnd - blockStart >= blockSize) {
+            vector<double> quality(numAlphas, 0.0);
+            vector<size_t> usage(numAlphas, 0);
+            for (auto t = 0; t < threads; t++) {
+                for (size_t i = 0; i < numAlphas; i++) {
+                    quality[i] += blockQuality[t][i];
+                    usage[i] += blockUsage[t][i];
+                }
+            }
+            updateProbabilities(probabilities, quality, usage);
             
             // Reset para próximo bloco
-            fill(blockQuality.begin(), blockQuality.end(), 0.0);
-            fill(blockUsage.begin(), blockUsage.end(), 0);
-            iterationsInBlock = 0;
+            for (auto t = 0; t < threads; t++) {
+                fill(blockQuality[t].begin(), blockQuality[t].end(), 0.0);
+                fill(blockUsage[t].begin(), blockUsage[t].end(), 0);
+            }
         }
     }
     
-    // Aplica busca local na melhor solução
-    bestSol = localSearch(bestSol, 100);
+    // Path relinking final entre todos os pares do pool combinado (em ordem de
+    // thread), partindo da melhor solução de cada par; o par k conta como a
+    // iteração iterations + k
+    if (eliteSize > 0 && boundHitIter == INT32_MAX && !timeExpired()) {
+        ElitePool combined(eliteSize, minDistance);
+        for (auto t = 0; t < threads; t++) combined.merge(elite[t]);
+        vector<pair<int, int>> pairs;
+        for (size_t i = 0; i < combined.size(); i++) {
+            for (size_t j = i + 1; j < combined.size(); j++) {
+                auto iBetter = combined[i].maxColor < combined[j].maxColor ||
+                               (combined[i].maxColor == combined[j].maxColor &&
+                                combined.iteration(i) < combined.iteration(j));
+                pairs.push_back(iBetter ? make_pair(i, j) : make_pair(j, i));
+            }
+        }
+        
+        auto pairCount = static_cast<int>(pairs.size());
+        pool.parallelFor(threads, [&](int t) {
+            for (auto k = t; k < pairCount; k += threads) {
+                if (timeExpired() || iterations + k > boundHitIter) break;
+                if (pathRelinking(combined[pairs[k].first], combined[pairs[k].second], rngs[t], workspaces[t])) {
+                    record(t, iterations + k, "relinking");
+                }
+            }
+        });
+    }
     
-    return bestSol;
+    return mergeThreadBest(threadBest, threadBestIter);
 }
 
-bool LPQColoring::isSolutionValid(const Solution& sol) const {
-    int n = graph->getNumVertices();
+RepairReport LPQColoring::repair(Solution& sol, const vector<GraphChange>& changes,
+                                  int improvementPasses) const {
+    RepairReport report;
+    auto n = graph->getNumVertices();
+    auto lostMax = false;  // Algum vértice deixou a maior cor
     
-    // Verifica se todos os vértices foram coloridos
-    for (auto i = 0; i < n; i++) {
-        if (sol.coloring[i] == -1) {
-            cerr << "Erro: vértice " << i << " não foi colorido" << endl;
-            return false;
-        }
+    // Vértices novos entram sem cor
+    vector<int> uncolored;
+    for (auto v = static_cast<int>(sol.coloring.size()); v < n; v++) {
+        uncolored.push_back(v);
     }
-    
-    // Verifica restrições
-    for (auto v = 0; v < n; v++) {
-        // Verifica vizinhos diretos
-        for (auto neighbor : graph->getNeighbors(v)) {
-            auto diff = abs(sol.coloring[v] - sol.coloring[neighbor]);
-            if (diff < p) {
-                cerr << "Erro: vértices adjacentes " << v << " e " << neighbor 
-                          << " violam restrição p" << endl;
-                return false;
+    sol.coloring.resize(n, -1);
+    
+    // Cada conflito novo envolve um extremo de aresta nova ou, com q > p, de
+    // aresta removida cujos extremos ficaram a distância 2 (a restrição entre
+    // eles passa de p para q). Os extremos são verificados em sequência, então
+    // descolorir u pode bastar para v.
+    vector<int> touched;
+    for (const auto& change : changes) {
+        auto tightened = change.type == ChangeType::RemoveEdge && q > p &&
+                         change.u >= 0 && change.u < n && change.v >= 0 && change.v < n &&
+                         graph->hasCommonNeighbor(change.u, change.v, -1);
+        for (auto x : {change.u, change.v}) {
+            if (x < 0 || x >= n) continue;
+            touched.push_back(x);
+            if (change.type != ChangeType::AddEdge && !tightened) continue;
+            
+            report.checked++;
+            auto color = sol.coloring[x];
+            if (color != -1 && !isValidColor(x, color, sol.coloring)) {
+                if (color == sol.maxColor) lostMax = true;
+                sol.coloring[x] = -1;
+                uncolored.push_back(x);
             }
         }
-        
-        // Verifica vizinhos a distância 2
-        for (auto neighbor2 : graph->getDistance2Neighbors(v)) {
-            auto diff = abs(sol.coloring[v] - sol.coloring[neighbor2]);
-            if (diff < q) {
-                cerr << "Erro: vértices a distância 2 " << v << " e " << neighbor2 
-                          << " violam restrição q" << endl;
-                return false;
-            }
+    }
+    
+    // Com maxColor + max(p, q) sempre válida, a busca no mapa de bits termina
+    ForbiddenColors scratch;
+    auto spread = max(p, q);
+    for (auto x : uncolored) {
+        if (sol.coloring[x] != -1) continue;
+        auto color = smallestValidColorBelow(x, sol.maxColor + spread + 1, sol.coloring, scratch);
+        sol.coloring[x] = color;
+        sol.maxColor = max(sol.maxColor, color);
+        touched.push_back(x);
+        report.recolored++;
+    }
+    
+    // Melhoria limitada aos vértices envolvidos e seus vizinhos (restrições
+    // removidas liberam cores nos dois), das cores mais altas para as mais baixas
+    vector<int> region(touched);
+    for (auto x : touched) {
+        for (auto neighbor : graph->getNeighbors(x)) region.push_back(neighbor);
+    }
+    sort(region.begin(), region.end());
+    region.erase(unique(region.begin(), region.end()), region.end());
+    
+    for (auto pass = 0; pass < improvementPasses; pass++) {
+        stable_sort(region.begin(), region.end(), [&sol](int a, int b) {
+            return sol.coloring[a] > sol.coloring[b];
+        });
+        auto moved = false;
+        for (auto x : region) {
+            auto color = sol.coloring[x];
+            auto newColor = smallestValidColorBelow(x, color, sol.coloring, scratch);
+            if (newColor >= color) continue;
+            if (color == sol.maxColor) lostMax = true;
+            sol.coloring[x] = newColor;
+            report.improved++;
+            moved = true;
         }
+        if (!moved) break;
     }
     
-    return true;
+    if (lostMax) {
+        sol.maxColor = n > 0 ? *max_element(sol.coloring.begin(), sol.coloring.end()) : 0;
+    }
+    return report;
+}
+
+ValidationReport LPQColoring::validate(const Solution& sol, int maxReported) const {
+    LPQ_TIME_SCOPE(instrumentation, Validation);
+    SolutionValidator validator(graph, p, q);
+    validator.setNumThreads(numThreads);
+    return validator.validate(sol.coloring, maxReported);
+}
+
+bool LPQColoring::isSolutionValid(const Solution& sol) const {
+    auto report = validate(sol, 5);
+    if (report.valid()) return true;
+    
+    if (report.uncolored > 0) {
+        cerr << "Erro: " << report.uncolored << " vértice(s) não foram coloridos" << endl;
+    }
+    if (report.totalViolations() > 0) {
+        cerr << "Erro: " << report.totalViolations() << " violação(ões) (" << report.distance1Violations
+             << " da restrição p, " << report.distance2Violations << " da restrição q)" << endl;
+    }
+    for (const auto& violation : report.violations) {
+        if (violation.adjacent) {
+            cerr << "Erro: vértices adjacentes " << violation.u << " e " << violation.v 
+                      << " violam restrição p" << endl;
+        } else {
+            cerr << "Erro: vértices a distância 2 " << violation.u << " e " << violation.v 
+                      << " violam restrição q" << endl;
+        }
+    }
+    return false;
 }
@@ -0,0 +1,103 @@
+#include "../include/LowerBound.h"
+#include <algorithm>
+
+using namespace std;
+
+int LowerBound::degreeBound(int maxDegree, int p, int q) {
+    if (maxDegree == 0) return 0;
+    if (maxDegree == 1) return p;
+    
+    // Os Δ vizinhos de v estão dois a dois a distância <= 2 (a 1 se forem
+    // adjacentes), então diferem de pelo menos s = min(p, q) e ocupam um
+    // intervalo de pelo menos (Δ-1)s. Se v fica fora dele soma-se p; se fica
+    // entre dois vizinhos, aquele intervalo passa de s para max(s, 2p).
+    auto s = min(p, q);
+    return (maxDegree - 1) * s + min(p, max(0, 2 * p - s));
+}
+
+int LowerBound::greedyClique(Graph* graph, int start, bool square,
+                             vector<int>& mark, int& stamp) {
+    auto weight = [&](int v) {
+        return square ? graph->getDegree(v) + graph->getDistance2Degree(v) : graph->getDegree(v);
+    };
+    
+    // Candidatos: vizinhança (fechada em G²) de start, maior grau primeiro
+    vector<int> candidates(graph->getNeighbors(start).begin(), graph->getNeighbors(start).end());
+    if (square) {
+        graph->forEachDistance2Neighbor(start, [&](int neighbor2) {
+            candidates.push_back(neighbor2);
+        });
+    }
+    sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+        auto wa = weight(a), wb = weight(b);
+        return wa != wb ? wa > wb : a < b;
+    });
+    
+    auto size = 1;
+    vector<int> remaining;
+    while (!candidates.empty()) {
+        auto u = candidates[0];
+        size++;
+        
+        // Mantém apenas os candidatos adjacentes a u (preservando a ordem)
+        stamp++;
+        for (auto neighbor : graph->getNeighbors(u)) mark[neighbor] = stamp;
+        if (square) {
+            graph->forEachDistance2Neighbor(u, [&](int neighbor2) {
+                mark[neighbor2] = stamp;
+            });
+        }
+        remaining.clear();
+        for (size_t i = 1; i < candidates.size(); i++) {
+            if (mark[candidates[i]] == stamp) remaining.push_back(candidates[i]);
+        }
+        candidates.swap(remaining);
+    }
+    
+    return size;
+}
+
+LowerBoundInfo LowerBound::compute(Graph* graph, int p, int q, int maxStarts) {
+    LowerBoundInfo info;
+    auto n = graph->getNumVertices();
+    if (n == 0) return info;
+    
+    for (auto v = 0; v < n; v++) {
+        info.maxDegree = max(info.maxDegree, graph->getDegree(v));
+    }
+    info.degreeBound = degreeBound(info.maxDegree, p, q);
+    
+    vector<int> mark(n, 0);
+    auto stamp = 0;
+    auto starts = min(n, max(1, maxStarts));
+    
+    for (auto square : {false, true}) {
+        vector<int> order(n);
+        for (auto v = 0; v < n; v++) order[v] = v;
+        vector<int> weight(n);
+        for (auto v = 0; v < n; v++) {
+            weight[v] = square ? graph->getDegree(v) + graph->getDistance2Degree(v) : graph->getDegree(v);
+        }
+        partial_sort(order.begin(), order.begin() + starts, order.end(), [&](int a, int b) {
+            return weight[a] != weight[b] ? weight[a] > weight[b] : a < b;
+        });
+        
+        auto best = 1;
+        for (auto i = 0; i < starts; i++) {
+            // Nenhuma clique a partir de v passa de grau + 1
+            if (weight[order[i]] + 1 <= best) break;
+            best = max(best, greedyClique(graph, order[i], square, mark, stamp));
+        }
+        
+        if (square) {
+            info.squareCliqueSize = best;
+            info.squareCliqueBound = (best - 1) * min(p, q);
+        } else {
+            info.cliqueSize = best;
+            info.cliqueBound = (best - 1) * p;
+        }
+    }
+    
+    info.value = max(info.degreeBound, max(info.cliqueBound, info.squareCliqueBound));
+    return info;
+}
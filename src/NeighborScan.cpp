@@ -0,0 +1,131 @@
+#include "../include/NeighborScan.h"
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LPQ_X86_SIMD 1
+#endif
+
+namespace {
+
+typedef int (*ScanFunction)(const int*, std::size_t, const int*, int, int);
+
+// EQUAL: limite 1, em que |color - c| < 1 é só c == color (e, com color >= 0,
+// vizinhos sem cor nunca casam); evita a subtração, o abs e a máscara de -1
+
+template<bool EQUAL>
+int scanScalar(const int* ids, std::size_t count, const int* coloring, int color, int limit) {
+    for (std::size_t i = 0; i < count; i++) {
+        auto c = coloring[ids[i]];
+        if (EQUAL ? c == color : c != -1 && std::abs(color - c) < limit) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+#ifdef LPQ_X86_SIMD
+
+// 4 vizinhos por vez; sem gather no SSE, as cores são carregadas uma a uma
+template<bool EQUAL>
+__attribute__((target("sse4.1")))
+int scanSSE4(const int* ids, std::size_t count, const int* coloring, int color, int limit) {
+    const __m128i colorVec = _mm_set1_epi32(color);
+    const __m128i limitVec = _mm_set1_epi32(limit);
+    const __m128i uncolored = _mm_set1_epi32(-1);
+    
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i colors = _mm_set_epi32(coloring[ids[i + 3]], coloring[ids[i + 2]],
+                                       coloring[ids[i + 1]], coloring[ids[i]]);
+        __m128i close;
+        if (EQUAL) {
+            close = _mm_cmpeq_epi32(colors, colorVec);
+        } else {
+            __m128i diff = _mm_abs_epi32(_mm_sub_epi32(colors, colorVec));
+            close = _mm_andnot_si128(_mm_cmpeq_epi32(colors, uncolored), _mm_cmplt_epi32(diff, limitVec));
+        }
+        auto mask = _mm_movemask_ps(_mm_castsi128_ps(close));
+        if (mask != 0) return static_cast<int>(i) + __builtin_ctz(mask);
+    }
+    
+    auto rest = scanScalar<EQUAL>(ids + i, count - i, coloring, color, limit);
+    return rest < 0 ? -1 : static_cast<int>(i) + rest;
+}
+
+// 8 vizinhos por vez com gather das cores a partir dos índices
+template<bool EQUAL>
+__attribute__((target("avx2")))
+int scanAVX2(const int* ids, std::size_t count, const int* coloring, int color, int limit) {
+    const __m256i colorVec = _mm256_set1_epi32(color);
+    const __m256i limitVec = _mm256_set1_epi32(limit);
+    const __m256i uncolored = _mm256_set1_epi32(-1);
+    
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        __m256i colors = _mm256_i32gather_epi32(coloring, indices, 4);
+        __m256i close;
+        if (EQUAL) {
+            close = _mm256_cmpeq_epi32(colors, colorVec);
+        } else {
+            __m256i diff = _mm256_abs_epi32(_mm256_sub_epi32(colors, colorVec));
+            close = _mm256_andnot_si256(_mm256_cmpeq_epi32(colors, uncolored),
+                                        _mm256_cmpgt_epi32(limitVec, diff));
+        }
+        auto mask = _mm256_movemask_ps(_mm256_castsi256_ps(close));
+        if (mask != 0) return static_cast<int>(i) + __builtin_ctz(mask);
+    }
+    
+    auto rest = scanScalar<EQUAL>(ids + i, count - i, coloring, color, limit);
+    return rest < 0 ? -1 : static_cast<int>(i) + rest;
+}
+
+#endif
+
+template<bool EQUAL>
+ScanFunction functionFor(NeighborScan::Isa isa) {
+#ifdef LPQ_X86_SIMD
+    if (isa == NeighborScan::Isa::AVX2) return scanAVX2<EQUAL>;
+    if (isa == NeighborScan::Isa::SSE4) return scanSSE4<EQUAL>;
+#else
+    (void)isa;
+#endif
+    return scanScalar<EQUAL>;
+}
+
+}
+
+NeighborScan::Isa NeighborScan::bestSupported() {
+#ifdef LPQ_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return Isa::SSE4;
+#endif
+    return Isa::Scalar;
+}
+
+const char* NeighborScan::name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "avx2";
+        case Isa::SSE4: return "sse4.1";
+        default: return "escalar";
+    }
+}
+
+int NeighborScan::firstWithin(const int* ids, std::size_t count, const int* coloring, int color, int limit) {
+    static const ScanFunction selected = functionFor<false>(bestSupported());
+    return selected(ids, count, coloring, color, limit);
+}
+
+int NeighborScan::firstWithin(Isa isa, const int* ids, std::size_t count, const int* coloring,
+                              int color, int limit) {
+    return functionFor<false>(isa)(ids, count, coloring, color, limit);
+}
+
+int NeighborScan::firstEqual(const int* ids, std::size_t count, const int* coloring, int color) {
+    static const ScanFunction selected = functionFor<true>(bestSupported());
+    return selected(ids, count, coloring, color, 1);
+}
+
+int NeighborScan::firstEqual(Isa isa, const int* ids, std::size_t count, const int* coloring, int color) {
+    return functionFor<true>(isa)(ids, count, coloring, color, 1);
+}
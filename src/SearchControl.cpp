@@ -0,0 +1,72 @@
+#include "../include/SearchControl.h"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <climits>
+
+SearchControl::SearchControl(double timeLimitSeconds, bool recordTrace)
+    : start(std::chrono::steady_clock::now()), timeLimit(timeLimitSeconds), timedOut(false),
+      tracing(recordTrace), bestKnown(INT_MAX) {
+}
+
+SearchControl::SearchControl(double timeLimitSeconds, bool recordTrace,
+                             std::chrono::steady_clock::time_point startTime)
+    : start(startTime), timeLimit(timeLimitSeconds), timedOut(false),
+      tracing(recordTrace), bestKnown(INT_MAX) {
+}
+
+double SearchControl::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double SearchControl::remaining() const {
+    if (timeLimit <= 0) return -1.0;
+    return timeLimit - elapsed();
+}
+
+bool SearchControl::expired() {
+    if (timedOut) return true;
+    if (timeLimit > 0 && elapsed() >= timeLimit) {
+        timedOut = true;
+    }
+    return timedOut;
+}
+
+void SearchControl::report(long long iteration, int maxColor, const char* phase) {
+    if (!tracing) return;
+    
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (maxColor < bestKnown) {
+        bestKnown = maxColor;
+        TracePoint point;
+        point.elapsed = elapsed();
+        point.iteration = iteration;
+        point.bestMaxColor = maxColor;
+        point.phase = phase;
+        trace.push_back(point);
+    }
+}
+
+bool SearchControl::saveTrace(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar arquivo de histórico: " << filename << std::endl;
+        return false;
+    }
+    
+    file << "elapsed,iteration,bestMaxColor,phase\n";
+    for (const auto& point : trace) {
+        file << std::fixed << std::setprecision(6) << point.elapsed << ","
+             << point.iteration << ","
+             << point.bestMaxColor << ","
+             << point.phase << "\n";
+    }
+    
+    // Disco cheio ou erro de E/S só aparecem ao descarregar o buffer
+    file.flush();
+    if (!file) {
+        std::cerr << "Erro ao gravar arquivo de histórico: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,508 @@
+#include "../include/Service.h"
+#include "../include/Experiment.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Valor de um campo da requisição (objeto JSON plano)
+struct JsonValue {
+    enum Type { String, Number, Bool, Null, NumberList } type;
+    std::string text;  // String já sem escapes, ou o texto original do número
+    double number;
+    bool flag;
+    std::vector<double> list;
+
+    JsonValue() : type(Null), number(0.0), flag(false) {}
+};
+
+typedef std::map<std::string, JsonValue> Request;
+
+// Parser mínimo para o formato das requisições: um objeto cujos valores são
+// strings, números, booleanos, null ou listas de números
+class RequestParser {
+private:
+    const std::string& text;
+    std::size_t pos;
+
+    void skipSpaces() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r')) pos++;
+    }
+
+    bool consume(char c) {
+        skipSpaces();
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) return false;
+        while (pos < text.size() && text[pos] != '"') {
+            auto c = text[pos++];
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos >= text.size()) return false;
+            c = text[pos++];
+            switch (c) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': {
+                    if (pos + 4 > text.size()) return false;
+                    auto code = std::strtol(text.substr(pos, 4).c_str(), nullptr, 16);
+                    pos += 4;
+                    out += code < 128 ? static_cast<char>(code) : '?';
+                    break;
+                }
+                default: out += c;  // \" \\ \/
+            }
+        }
+        return consume('"');
+    }
+
+    bool parseNumber(double& out, std::string& raw) {
+        skipSpaces();
+        auto begin = text.c_str() + pos;
+        char* end = nullptr;
+        out = std::strtod(begin, &end);
+        if (end == begin) return false;
+        raw.assign(begin, end - begin);
+        pos += end - begin;
+        return true;
+    }
+
+    bool parseLiteral(const char* literal) {
+        skipSpaces();
+        auto length = std::strlen(literal);
+        if (text.compare(pos, length, literal) != 0) return false;
+        pos += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value) {
+        skipSpaces();
+        if (pos >= text.size()) return false;
+        auto c = text[pos];
+        if (c == '"') {
+            value.type = JsonValue::String;
+            return parseString(value.text);
+        }
+        if (c == '[') {
+            pos++;
+            value.type = JsonValue::NumberList;
+            if (consume(']')) return true;
+            do {
+                double number;
+                std::string raw;
+                if (!parseNumber(number, raw)) return false;
+                value.list.push_back(number);
+            } while (consume(','));
+            return consume(']');
+        }
+        if (parseLiteral("true")) {
+            value.type = JsonValue::Bool;
+            value.flag = true;
+            return true;
+        }
+        if (parseLiteral("false")) {
+            value.type = JsonValue::Bool;
+            return true;
+        }
+        if (parseLiteral("null")) {
+            value.type = JsonValue::Null;
+            return true;
+        }
+        value.type = JsonValue::Number;
+        return parseNumber(value.number, value.text);
+    }
+
+public:
+    explicit RequestParser(const std::string& line) : text(line), pos(0) {}
+
+    bool parse(Request& request) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        do {
+            std::string key;
+            JsonValue value;
+            if (!parseString(key) || !consume(':') || !parseValue(value)) return false;
+            request[key] = value;
+        } while (consume(','));
+        if (!consume('}')) return false;
+        skipSpaces();
+        return pos == text.size();
+    }
+};
+
+std::string jsonString(const std::string& text) {
+    std::ostringstream out;
+    out << '"';
+    for (auto c : text) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            case '\r': out << "\\r"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    out << code;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+// "id" é devolvido como veio: string ou número
+std::string requestId(const Request& request) {
+    auto it = request.find("id");
+    if (it == request.end()) return "null";
+    if (it->second.type == JsonValue::String) return jsonString(it->second.text);
+    if (it->second.type == JsonValue::Number) return it->second.text;
+    return "null";
+}
+
+std::string errorResponse(const std::string& id, const std::string& message) {
+    return "{\"id\":" + id + ",\"status\":\"error\",\"message\":" + jsonString(message) + "}";
+}
+
+// Acesso tipado aos campos; false se o campo existe com tipo incompatível
+bool getString(const Request& request, const std::string& key, std::string& out) {
+    auto it = request.find(key);
+    if (it == request.end() || it->second.type == JsonValue::Null) return true;
+    if (it->second.type != JsonValue::String) return false;
+    out = it->second.text;
+    return true;
+}
+
+bool getNumber(const Request& request, const std::string& key, double& out) {
+    auto it = request.find(key);
+    if (it == request.end() || it->second.type == JsonValue::Null) return true;
+    if (it->second.type != JsonValue::Number) return false;
+    out = it->second.number;
+    return true;
+}
+
+template<typename T>
+bool getInteger(const Request& request, const std::string& key, T& out) {
+    double value = static_cast<double>(out);
+    if (!getNumber(request, key, value) || value != std::floor(value) || value < 0) return false;
+    out = static_cast<T>(value);
+    return true;
+}
+
+bool getBool(const Request& request, const std::string& key, bool& out) {
+    auto it = request.find(key);
+    if (it == request.end() || it->second.type == JsonValue::Null) return true;
+    if (it->second.type != JsonValue::Bool) return false;
+    out = it->second.flag;
+    return true;
+}
+
+// Monta a configuração a partir da requisição; devolve a mensagem de erro ou ""
+std::string readConfig(const Request& request, double defaultTimeLimit, ExperimentConfig& config, bool& sendColoring) {
+    config.p = -1;
+    config.q = -1;
+    config.timeLimit = defaultTimeLimit;
+    config.seed = Utils::generateSeed();
+    config.iterations = -1;
+    sendColoring = true;
+
+    if (!getString(request, "algorithm", config.algorithm) || config.algorithm.empty()) {
+        return "campo \"algorithm\" ausente ou inválido";
+    }
+    if (!Experiment::isKnownAlgorithm(config.algorithm)) {
+        return "algoritmo desconhecido: " + config.algorithm;
+    }
+    if (!getInteger(request, "p", config.p) || !getInteger(request, "q", config.q) || config.p < 0 || config.q < 0) {
+        return "campos \"p\" e \"q\" devem ser inteiros não negativos";
+    }
+    if (!getNumber(request, "alpha", config.alpha)) return "campo \"alpha\" inválido";
+    auto alphas = request.find("alphas");
+    if (alphas != request.end()) {
+        if (alphas->second.type != JsonValue::NumberList || alphas->second.list.empty()) {
+            return "campo \"alphas\" deve ser uma lista de números";
+        }
+        config.alphas = alphas->second.list;
+    }
+    auto iterations = request.find("iterations");
+    if (iterations != request.end() && !getInteger(request, "iterations", config.iterations)) {
+        return "campo \"iterations\" inválido";
+    }
+    if (config.iterations < 0) {
+        config.iterations = config.algorithm == "randomized" ? 30 : config.algorithm == "reactive" ? 300 : 0;
+    }
+    if (!getInteger(request, "blockSize", config.blockSize)) return "campo \"blockSize\" inválido";
+    if (!getInteger(request, "eliteSize", config.eliteSize)) return "campo \"eliteSize\" inválido";
+    if (!getString(request, "init", config.initial) || !Experiment::isKnownInitial(config.initial)) {
+        return "campo \"init\" inválido";
+    }
+    if (!getInteger(request, "seed", config.seed)) return "campo \"seed\" inválido";
+    if (!getInteger(request, "threads", config.threads)) return "campo \"threads\" inválido";
+    if (config.threads <= 0) config.threads = 1;
+    if (!getString(request, "improvement", config.improvement) ||
+        !Experiment::isKnownImprovement(config.improvement)) {
+        return "campo \"improvement\" inválido";
+    }
+    if (!getInteger(request, "tabuIterations", config.tabuIterations)) return "campo \"tabuIterations\" inválido";
+    if (!getNumber(request, "tabuTimeLimit", config.tabuTimeLimit)) return "campo \"tabuTimeLimit\" inválido";
+    if (!getNumber(request, "timeLimit", config.timeLimit)) return "campo \"timeLimit\" inválido";
+    if (!getBool(request, "earlyStop", config.earlyStop)) return "campo \"earlyStop\" inválido";
+    if (!getBool(request, "coloring", sendColoring)) return "campo \"coloring\" inválido";
+    return "";
+}
+
+}  // namespace
+
+SolverService::Connection::~Connection() {
+    if (owned) ::close(output);
+}
+
+void SolverService::Connection::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto data = line + "\n";
+    std::size_t written = 0;
+    while (written < data.size()) {
+        auto count = ::write(output, data.data() + written, data.size() - written);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return;  // Cliente desconectado: a resposta é descartada
+        written += count;
+    }
+}
+
+SolverService::SolverService(const ServiceOptions& options)
+    : options(options), registry(options.registryCapacity, options.graphOptions),
+      pool(options.workers), stopping(false), listenFd(-1) {}
+
+void SolverService::requestShutdown() {
+    stopping = true;
+    if (listenFd >= 0) ::shutdown(listenFd, SHUT_RDWR);
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    for (auto fd : clients) ::shutdown(fd, SHUT_RD);
+}
+
+void SolverService::handleLine(const std::string& line, const std::shared_ptr<Connection>& connection) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) return;
+
+    // O tempo limite e o totalTime contam a partir daqui: incluem a espera por
+    // um worker e a leitura do grafo
+    auto arrival = std::chrono::steady_clock::now();
+
+    Request request;
+    if (!RequestParser(line).parse(request)) {
+        connection->send(errorResponse(requestId(request), "JSON inválido"));
+        return;
+    }
+    auto id = requestId(request);
+    std::string op = "solve";
+    if (!getString(request, "op", op)) {
+        connection->send(errorResponse(id, "campo \"op\" inválido"));
+        return;
+    }
+
+    if (op == "stats") {
+        connection->send("{\"id\":" + id + ",\"status\":\"ok\"," + registry.statsJSON() + "}");
+        return;
+    }
+    if (op == "shutdown") {
+        // Requisições já aceitas ainda são respondidas
+        connection->send("{\"id\":" + id + ",\"status\":\"ok\"}");
+        requestShutdown();
+        return;
+    }
+    if (op != "solve" && op != "load") {
+        connection->send(errorResponse(id, "operação desconhecida: " + op));
+        return;
+    }
+
+    std::string instance;
+    if (!getString(request, "instance", instance) || instance.empty()) {
+        connection->send(errorResponse(id, "campo \"instance\" ausente ou inválido"));
+        return;
+    }
+
+    ExperimentConfig config;
+    auto sendColoring = true;
+    if (op == "solve") {
+        auto error = readConfig(request, options.timeLimit, config, sendColoring);
+        if (!error.empty()) {
+            connection->send(errorResponse(id, error));
+            return;
+        }
+    
+        // Mais threads que núcleos só disputariam a CPU com as outras requisições
+        config.threads = std::min(config.threads, ThreadPool::hardwareThreads());
+    }
+
+    pool.submit([this, op, id, instance, config, sendColoring, connection, arrival]() {
+        auto cached = false;
+        auto registered = registry.acquire(instance, cached);
+        if (registered == nullptr) {
+            connection->send(errorResponse(id, "não foi possível ler a instância: " + instance));
+            return;
+        }
+
+        std::ostringstream response;
+        response.precision(9);
+        response << "{\"id\":" << id << ",\"status\":\"ok\",\"instance\":" << jsonString(instance)
+                 << ",\"vertices\":" << registered->graph->getNumVertices()
+                 << ",\"cached\":" << (cached ? "true" : "false")
+                 << ",\"loadTime\":" << (cached ? 0.0 : registered->loadTime);
+
+        if (op == "solve") {
+            auto solveConfig = config;
+            solveConfig.lowerBound = registered->lowerBound(config.p, config.q);
+
+            Solution solution;
+            auto valid = false;
+            auto result = Experiment::run(registered->graph.get(), instance, solveConfig, solution, valid, &arrival);
+            auto total = std::chrono::duration<double>(std::chrono::steady_clock::now() - arrival).count();
+
+            response << ",\"algorithm\":" << jsonString(result.algorithm) << ",\"p\":" << config.p
+                     << ",\"q\":" << config.q << ",\"seed\":" << config.seed << ",\"threads\":" << config.threads
+                     << ",\"maxColor\":" << solution.maxColor << ",\"valid\":" << (valid ? "true" : "false")
+                     << ",\"lowerBound\":" << result.lowerBound << ",\"gap\":" << result.gap
+                     << ",\"solveTime\":" << result.executionTime << ",\"totalTime\":" << total;
+            if (sendColoring) {
+                response << ",\"coloring\":[";
+                for (std::size_t v = 0; v < solution.coloring.size(); v++) {
+                    response << (v > 0 ? "," : "") << solution.coloring[v];
+                }
+                response << "]";
+            }
+        }
+        response << "}";
+        connection->send(response.str());
+    });
+}
+
+void SolverService::serveConnection(std::shared_ptr<Connection> connection) {
+    std::string buffer;
+    char chunk[65536];
+    while (!stopping) {
+        auto count = ::read(connection->input, chunk, sizeof(chunk));
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        buffer.append(chunk, count);
+
+        std::size_t begin = 0;
+        auto end = buffer.find('\n');
+        while (end != std::string::npos && !stopping) {
+            handleLine(buffer.substr(begin, end - begin), connection);
+            begin = end + 1;
+            end = buffer.find('\n', begin);
+        }
+        buffer.erase(0, begin);
+    }
+    if (!stopping && !buffer.empty()) handleLine(buffer, connection);
+}
+
+int SolverService::runStdio() {
+    // stdout passa a ser só do protocolo: mensagens das bibliotecas vão para stderr
+    auto coutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+    std::cerr << "Serviço atendendo em stdin/stdout (" << options.workers << " worker(s))" << std::endl;
+
+    auto connection = std::make_shared<Connection>(STDIN_FILENO, STDOUT_FILENO, false);
+    serveConnection(connection);
+    pool.wait();
+
+    std::cout.rdbuf(coutBuffer);
+    return 0;
+}
+
+int SolverService::runSocket() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (options.socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Erro: caminho do socket muito longo: " << options.socketPath << std::endl;
+        return 1;
+    }
+    std::strcpy(address.sun_path, options.socketPath.c_str());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Erro ao criar socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    ::unlink(options.socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listenFd, 64) < 0) {
+        std::cerr << "Erro ao abrir socket " << options.socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(listenFd);
+        listenFd = -1;
+        return 1;
+    }
+    std::cout << "Serviço ouvindo em " << options.socketPath << " (" << options.workers << " worker(s))" << std::endl;
+
+    while (!stopping) {
+        auto fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            if (stopping) {
+                ::close(fd);
+                break;
+            }
+            clients.insert(fd);
+        }
+        std::thread([this, fd]() {
+            // O fd só é fechado quando a última resposta pendente for enviada;
+            // sai de clients antes disso para não ser confundido com um fd reutilizado
+            auto connection = std::make_shared<Connection>(fd, fd, true);
+            serveConnection(connection);
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            clients.erase(fd);
+            if (clients.empty()) clientsDone.notify_all();
+        }).detach();
+    }
+
+    requestShutdown();
+    {
+        std::unique_lock<std::mutex> lock(clientsMutex);
+        clientsDone.wait(lock, [this]() { return clients.empty(); });
+    }
+    pool.wait();
+
+    ::close(listenFd);
+    listenFd = -1;
+    ::unlink(options.socketPath.c_str());
+    std::cout << "Serviço encerrado" << std::endl;
+    return 0;
+}
+
+int SolverService::run() {
+    // Escrita para um cliente desconectado não deve encerrar o processo
+    std::signal(SIGPIPE, SIG_IGN);
+    return options.socketPath.empty() ? runStdio() : runSocket();
+}
@@ -0,0 +1,107 @@
+#include "../include/SolutionValidator.h"
+#include "../include/NeighborScan.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Parte de uma lista ordenada com vizinhos maiores que v
+NeighborRange after(const NeighborRange& range, int v) {
+    return NeighborRange(std::upper_bound(range.begin(), range.end(), v), range.end());
+}
+
+}
+
+SolutionValidator::SolutionValidator(Graph* g, int p_val, int q_val)
+    : graph(g), p(p_val), q(q_val), numThreads(1) {
+}
+
+void SolutionValidator::setNumThreads(int threads) {
+    numThreads = std::max(1, threads);
+}
+
+ValidationReport SolutionValidator::validate(const std::vector<int>& coloring, int maxReported) const {
+    const int chunkSize = 256;
+    auto n = graph->getNumVertices();
+    auto numChunks = (n + chunkSize - 1) / chunkSize;
+    auto threads = std::max(1, std::min(numThreads, numChunks));
+    
+    // Contagens por thread; violações guardadas por bloco para manter a ordem por u
+    std::vector<ValidationReport> partial(threads);
+    std::vector<std::vector<ConstraintViolation>> chunkViolations(numChunks);
+    auto limit = static_cast<std::size_t>(std::max(0, maxReported));
+    
+    ThreadPool pool(threads);
+    pool.parallelFor(threads, [&](int t) {
+        auto& report = partial[t];
+        for (auto chunk = t; chunk < numChunks; chunk += threads) {
+            auto& found = chunkViolations[chunk];
+            auto record = [&](int u, int v, bool adjacent) {
+                if (found.size() < limit) {
+                    ConstraintViolation violation;
+                    violation.u = u;
+                    violation.v = v;
+                    violation.adjacent = adjacent;
+                    found.push_back(violation);
+                }
+            };
+            
+            auto last = std::min(n, (chunk + 1) * chunkSize);
+            for (auto v = chunk * chunkSize; v < last; v++) {
+                auto color = coloring[v];
+                if (color == -1) {
+                    report.uncolored++;
+                    continue;
+                }
+                
+                // Distância 1: varredura vetorizada retomada após cada conflito
+                auto neighbors = after(graph->getNeighbors(v), v);
+                for (std::size_t i = 0; i < neighbors.size(); i++) {
+                    auto index = NeighborScan::firstWithin(neighbors.data() + i, neighbors.size() - i,
+                                                           coloring.data(), color, p);
+                    if (index < 0) break;
+                    i += index;
+                    report.distance1Violations++;
+                    record(v, neighbors[i], true);
+                }
+                
+                // Distância 2
+                if (!graph->isDistance2Implicit()) {
+                    auto neighbors2 = after(graph->getDistance2Neighbors(v), v);
+                    for (std::size_t i = 0; i < neighbors2.size(); i++) {
+                        auto index = NeighborScan::firstWithin(neighbors2.data() + i, neighbors2.size() - i,
+                                                               coloring.data(), color, q);
+                        if (index < 0) break;
+                        i += index;
+                        report.distance2Violations++;
+                        record(v, neighbors2[i], false);
+                    }
+                } else {
+                    graph->forEachDistance2Neighbor(v, [&](int neighbor2) {
+                        auto c = coloring[neighbor2];
+                        if (neighbor2 > v && c != -1 && std::abs(color - c) < q) {
+                            report.distance2Violations++;
+                            record(v, neighbor2, false);
+                        }
+                    });
+                }
+            }
+        }
+    });
+    
+    ValidationReport result;
+    for (const auto& report : partial) {
+        result.uncolored += report.uncolored;
+        result.distance1Violations += report.distance1Violations;
+        result.distance2Violations += report.distance2Violations;
+    }
+    for (const auto& found : chunkViolations) {
+        for (const auto& violation : found) {
+            if (result.violations.size() >= limit) break;
+            result.violations.push_back(violation);
+        }
+    }
+    
+    return result;
+}
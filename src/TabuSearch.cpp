@@ -0,0 +1,189 @@
+#include "../include/TabuSearch.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+using namespace std;
+
+namespace {
+
+double secondsSince(const chrono::steady_clock::time_point& start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+}
+
+TabuSearch::TabuSearch(Graph* g, int p_val, int q_val, unsigned int seed)
+    : graph(g), p(p_val), q(q_val), rng(seed), iterationLimit(100000), timeLimit(0.0),
+      iterations(0), control(nullptr), lowerBound(-1),
+      instrumentation(nullptr), memoryLimit(size_t(1024) << 20), width(0) {
+}
+
+void TabuSearch::applyColor(int vertex, int color, int sign) {
+    auto lo = max(0, color - p + 1);
+    auto hi = min(width - 1, color + p - 1);
+    for (auto neighbor : graph->getNeighbors(vertex)) {
+        auto row = conflicts.data() + static_cast<size_t>(neighbor) * width;
+        for (auto c = lo; c <= hi; c++) row[c] += sign;
+    }
+    
+    lo = max(0, color - q + 1);
+    hi = min(width - 1, color + q - 1);
+    graph->forEachDistance2Neighbor(vertex, [&](int neighbor2) {
+        auto row = conflicts.data() + static_cast<size_t>(neighbor2) * width;
+        for (auto c = lo; c <= hi; c++) row[c] += sign;
+    });
+}
+
+void TabuSearch::refreshConflicting(int vertex, const vector<int>& coloring) {
+    auto inConflict = conflicts[static_cast<size_t>(vertex) * width + coloring[vertex]] > 0;
+    
+    if (inConflict && conflictingPos[vertex] == -1) {
+        conflictingPos[vertex] = static_cast<int>(conflicting.size());
+        conflicting.push_back(vertex);
+    } else if (!inConflict && conflictingPos[vertex] != -1) {
+        auto last = conflicting.back();
+        conflicting[conflictingPos[vertex]] = last;
+        conflictingPos[last] = conflictingPos[vertex];
+        conflicting.pop_back();
+        conflictingPos[vertex] = -1;
+    }
+}
+
+bool TabuSearch::solveSpan(int k, vector<int>& coloring, double deadline) {
+    auto n = graph->getNumVertices();
+    auto start = chrono::steady_clock::now();
+    
+    // Vértices acima do span alvo recebem a cor de menor conflito em [0, k]
+    for (auto v = 0; v < n; v++) {
+        if (coloring[v] <= k) continue;
+        applyColor(v, coloring[v], -1);
+        auto row = conflicts.data() + static_cast<size_t>(v) * width;
+        coloring[v] = static_cast<int>(min_element(row, row + k + 1) - row);
+        applyColor(v, coloring[v], +1);
+    }
+    
+    conflicting.clear();
+    conflictingPos.assign(n, -1);
+    long long total = 0;
+    for (auto v = 0; v < n; v++) {
+        total += conflicts[static_cast<size_t>(v) * width + coloring[v]];
+        refreshConflicting(v, coloring);
+    }
+    total /= 2;  // Cada par em conflito foi contado nos dois extremos
+    auto bestTotal = total;
+    
+    while (total > 0) {
+        if (iterationLimit > 0 && iterations >= iterationLimit) return false;
+        if ((iterations & 63) == 0) {
+            if (deadline > 0 && secondsSince(start) >= deadline) return false;
+            if (control != nullptr && control->expired()) return false;
+        }
+        iterations++;
+        
+        // Melhor movimento (v, c) entre os vértices em conflito; movimentos tabu
+        // só são aceitos se levarem a um total melhor que o melhor já visto
+        auto bestDelta = INT_MAX;
+        auto moveVertex = -1;
+        auto moveColor = -1;
+        auto ties = 0;
+        for (auto v : conflicting) {
+            auto row = conflicts.data() + static_cast<size_t>(v) * width;
+            auto tabuRow = tabuUntil.data() + static_cast<size_t>(v) * width;
+            auto current = row[coloring[v]];
+            
+            for (auto c = 0; c <= k; c++) {
+                if (c == coloring[v]) continue;
+                auto delta = row[c] - current;
+                if (tabuRow[c] > iterations && total + delta >= bestTotal) continue;
+                
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    moveVertex = v;
+                    moveColor = c;
+                    ties = 1;
+                } else if (delta == bestDelta && uniform_int_distribution<int>(0, ties++)(rng) == 0) {
+                    moveVertex = v;
+                    moveColor = c;
+                }
+            }
+        }
+        
+        // Todos os movimentos são tabu: perturba um vértice em conflito ao acaso
+        if (moveVertex == -1) {
+            moveVertex = conflicting[uniform_int_distribution<int>(0, conflicting.size() - 1)(rng)];
+            moveColor = uniform_int_distribution<int>(0, k)(rng);
+            if (moveColor == coloring[moveVertex]) continue;
+            auto row = conflicts.data() + static_cast<size_t>(moveVertex) * width;
+            bestDelta = row[moveColor] - row[coloring[moveVertex]];
+        }
+        
+        auto oldColor = coloring[moveVertex];
+        applyColor(moveVertex, oldColor, -1);
+        coloring[moveVertex] = moveColor;
+        applyColor(moveVertex, moveColor, +1);
+        total += bestDelta;
+        
+        // Proíbe a volta à cor antiga por um número de iterações proporcional aos conflitos
+        tabuUntil[static_cast<size_t>(moveVertex) * width + oldColor] =
+            iterations + uniform_int_distribution<int>(0, 9)(rng) +
+            static_cast<long long>(0.6 * conflicting.size());
+        
+        refreshConflicting(moveVertex, coloring);
+        for (auto neighbor : graph->getNeighbors(moveVertex)) {
+            refreshConflicting(neighbor, coloring);
+        }
+        graph->forEachDistance2Neighbor(moveVertex, [&](int neighbor2) {
+            refreshConflicting(neighbor2, coloring);
+        });
+        
+        bestTotal = min(bestTotal, total);
+    }
+    
+    return true;
+}
+
+Solution TabuSearch::improve(const Solution& initial) {
+    LPQ_TIME_SCOPE(instrumentation, Improvement);
+    auto n = graph->getNumVertices();
+    auto start = chrono::steady_clock::now();
+    iterations = 0;
+    
+    Solution best = initial;
+    if (best.maxColor <= 0) return best;
+    
+    // Tabelas com as cores 0..maxColor-1 (o primeiro alvo é maxColor-1)
+    width = best.maxColor;
+    auto entries = static_cast<size_t>(n) * width;
+    auto bytes = entries * (sizeof(int) + sizeof(long long));
+    if (memoryLimit > 0 && bytes > memoryLimit) {
+        cerr << "Aviso: busca tabu ignorada (tabelas de " << ((bytes + (size_t(1) << 20) - 1) >> 20) << " MB para "
+             << entries << " pares vértice-cor excedem -tabu-mem " << (memoryLimit >> 20) << " MB)" << endl;
+        return best;
+    }
+    conflicts.assign(static_cast<size_t>(n) * width, 0);
+    tabuUntil.assign(static_cast<size_t>(n) * width, 0);
+    
+    auto coloring = best.coloring;
+    for (auto v = 0; v < n; v++) {
+        applyColor(v, coloring[v], +1);
+    }
+    
+    for (auto k = best.maxColor - 1; k >= max(0, lowerBound); k = best.maxColor - 1) {
+        auto remaining = 0.0;
+        if (timeLimit > 0) {
+            remaining = timeLimit - secondsSince(start);
+            if (remaining <= 0) break;
+        }
+        
+        if (!solveSpan(k, coloring, remaining)) break;
+        
+        best.coloring = coloring;
+        best.maxColor = *max_element(coloring.begin(), coloring.end());
+        if (control != nullptr) control->report(iterations, best.maxColor, "tabu");
+    }
+    
+    LPQ_COUNT(instrumentation, TabuIterations, iterations);
+    return best;
+}
@@ -0,0 +1,70 @@
+#include "../include/ThreadPool.h"
+
+ThreadPool::ThreadPool(int numThreads) : pending(0), stopping(false) {
+    if (numThreads < 1) numThreads = 1;
+    for (auto i = 0; i < numThreads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;  // stopping e sem trabalho restante
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        
+        task();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+            if (pending == 0) allDone.notify_all();
+        }
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+        pending++;
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this]() { return pending == 0; });
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& func) {
+    if (count == 1) {
+        func(0);
+        return;
+    }
+    for (auto i = 0; i < count; i++) {
+        submit([&func, i]() { func(i); });
+    }
+    wait();
+}
+
+int ThreadPool::hardwareThreads() {
+    auto n = static_cast<int>(std::thread::hardware_concurrency());
+    return n > 0 ? n : 1;
+}
@@ -2,6 +2,7 @@
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <ctime>
 #include <sys/stat.h>
 
@@ -13,43 +14,112 @@ std::string Utils::getCurrentDateTime() {
     return std::string(buffer);
 }
 
-void Utils::createCSVHeaderIfNeeded(const std::string& filename) {
+const char* Utils::csvHeader() {
+    return "datetime,instance,p,q,algorithm,alpha,iterations,blockSize,seed,executionTime,"
+           "bestSolution,avgSolution,bestAlpha,threads,lowerBound,gap";
+}
+
+bool Utils::createCSVHeaderIfNeeded(const std::string& filename) {
     struct stat buffer;
     bool fileExists = (stat(filename.c_str(), &buffer) == 0);
     
-    if (!fileExists) {
+    // Arquivo vazio recebe o cabeçalho como se não existisse
+    if (!fileExists || buffer.st_size == 0) {
         std::ofstream file(filename);
         if (file.is_open()) {
-            file << "datetime,instance,p,q,algorithm,alpha,iterations,blockSize,seed,executionTime,bestSolution,avgSolution,bestAlpha\n";
+            file << csvHeader() << "\n";
             file.close();
         }
+        return true;
+    }
+    
+    // Linhas com outro número de colunas desalinhariam o arquivo
+    std::ifstream file(filename);
+    std::string header;
+    std::getline(file, header);
+    if (!header.empty() && header.back() == '\r') header.pop_back();
+    if (header != csvHeader()) {
+        std::cerr << "Erro: o cabeçalho de " << filename << " não corresponde às colunas atuais ("
+                  << csvHeader() << "); use outro arquivo com -csv ou migre o existente" << std::endl;
+        return false;
     }
+    return true;
 }
 
-void Utils::saveResultToCSV(const ExecutionResult& result, const std::string& filename) {
-    createCSVHeaderIfNeeded(filename);
+std::string Utils::formatCSVRow(const ExecutionResult& result) {
+    std::ostringstream row;
+    row << result.datetime << ","
+        << result.instance << ","
+        << result.p << ","
+        << result.q << ","
+        << result.algorithm << ","
+        << result.alpha << ","
+        << result.iterations << ","
+        << result.blockSize << ","
+        << result.seed << ","
+        << std::fixed << std::setprecision(6) << result.executionTime << ","
+        << result.bestSolution << ","
+        << std::fixed << std::setprecision(2) << result.avgSolution << ","
+        << std::fixed << std::setprecision(3) << result.bestAlpha << ","
+        << result.threads << ","
+        << result.lowerBound << ","
+        << std::fixed << std::setprecision(4) << result.gap << "\n";
+    return row.str();
+}
+
+bool Utils::saveResultToCSV(const ExecutionResult& result, const std::string& filename) {
+    return saveResultsToCSV(std::vector<ExecutionResult>(1, result), filename);
+}
+
+std::string Utils::instrumentationFile(const std::string& csvFile) {
+    auto base = csvFile;
+    if (base.size() > 4 && base.compare(base.size() - 4, 4, ".csv") == 0) {
+        base.erase(base.size() - 4);
+    }
+    return base + ".instrument.jsonl";
+}
+
+bool Utils::saveResultsToCSV(const std::vector<ExecutionResult>& results, const std::string& filename) {
+    if (!createCSVHeaderIfNeeded(filename)) return false;
+    
+    std::string buffer;
+    std::string sidecar;
+    for (const auto& result : results) {
+        buffer += formatCSVRow(result);
+        
+        // Mesma identificação da linha do CSV seguida dos contadores
+        if (!result.instrumentation.empty()) {
+            std::ostringstream line;
+            line << "{\"datetime\": \"" << result.datetime << "\", \"instance\": \"" << result.instance
+                 << "\", \"p\": " << result.p << ", \"q\": " << result.q
+                 << ", \"algorithm\": \"" << result.algorithm << "\", \"alpha\": \"" << result.alpha
+                 << "\", \"iterations\": " << result.iterations << ", \"blockSize\": " << result.blockSize
+                 << ", \"seed\": " << result.seed << ", \"threads\": " << result.threads
+                 << ", \"bestSolution\": " << result.bestSolution
+                 << ", \"executionTime\": " << std::fixed << std::setprecision(6) << result.executionTime
+                 << ", " << result.instrumentation.substr(1) << "\n";
+            sidecar += line.str();
+        }
+    }
+    
+    if (!sidecar.empty()) {
+        std::ofstream sidecarFile(instrumentationFile(filename), std::ios::app);
+        if (sidecarFile.is_open()) {
+            sidecarFile << sidecar;
+        } else {
+            std::cerr << "Erro ao abrir arquivo de instrumentação: " << instrumentationFile(filename) << std::endl;
+        }
+    }
     
     std::ofstream file(filename, std::ios::app);
     if (!file.is_open()) {
         std::cerr << "Erro ao abrir arquivo CSV: " << filename << std::endl;
-        return;
+        return false;
     }
     
-    file << result.datetime << ","
-         << result.instance << ","
-         << result.p << ","
-         << result.q << ","
-         << result.algorithm << ","
-         << result.alpha << ","
-         << result.iterations << ","
-         << result.blockSize << ","
-         << result.seed << ","
-         << std::fixed << std::setprecision(6) << result.executionTime << ","
-         << result.bestSolution << ","
-         << std::fixed << std::setprecision(2) << result.avgSolution << ","
-         << std::fixed << std::setprecision(3) << result.bestAlpha << "\n";
-    
+    file << buffer;
     file.close();
+    return true;
 }
 
 void Utils::printSolution(const Solution& sol, const std::string& filename) {
@@ -77,6 +147,38 @@ void Utils::printSolution(const Solution& sol, const std::string& filename) {
     }
 }
 
+bool Utils::readGraphChanges(const std::string& filename, std::vector<GraphChange>& changes) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao abrir arquivo de alterações: " << filename << std::endl;
+        return false;
+    }
+    
+    std::string line;
+    auto lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream ss(line);
+        std::string kind;
+        if (!(ss >> kind) || kind[0] == 'c') continue;
+        
+        int u = 0, v = 0;
+        if (kind == "e+" && ss >> u >> v) {
+            changes.push_back(GraphChange(ChangeType::AddEdge, u - 1, v - 1));
+        } else if (kind == "e-" && ss >> u >> v) {
+            changes.push_back(GraphChange(ChangeType::RemoveEdge, u - 1, v - 1));
+        } else if (kind == "v+") {
+            changes.push_back(GraphChange(ChangeType::AddVertex));
+        } else if (kind == "v-" && ss >> u) {
+            changes.push_back(GraphChange(ChangeType::RemoveVertex, u - 1));
+        } else {
+            std::cerr << "Erro: linha " << lineNumber << " inválida em " << filename << ": " << line << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
 unsigned int Utils::generateSeed() {
     return static_cast<unsigned int>(time(nullptr));
 }
@@ -1,12 +1,15 @@
 #include "../include/Graph.h"
 #include "../include/LPQColoring.h"
 #include "../include/Utils.h"
+#include "../include/ThreadPool.h"
+#include "../include/Experiment.h"
+#include "../include/LowerBound.h"
+#include "../include/Service.h"
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <algorithm>
 #include <vector>
-#include <sstream>
-#include <iomanip>
 
 void printUsage(const char* programName) {
     std::cout << "\n=== L(p,q)-Coloring Solver ===" << std::endl;
@@ -15,7 +18,9 @@ void printUsage(const char* programName) {
     std::cout << "  -f <arquivo>     Arquivo de instância" << std::endl;
     std::cout << "  -p <valor>       Valor de p (diferença mínima para adjacentes)" << std::endl;
     std::cout << "  -q <valor>       Valor de q (diferença mínima para distância 2)" << std::endl;
-    std::cout << "  -a <algoritmo>   Algoritmo: greedy | randomized | reactive" << std::endl;
+    std::cout << "  -a <algoritmo>   Algoritmo: greedy | dsatur | randomized | reactive | exact" << std::endl;
+    std::cout << "\nOpções para algoritmos randomized e reactive:" << std::endl;
+    std::cout << "  -init <tipo>     Solução inicial dos laços GRASP: none | dsatur (padrão: none)" << std::endl;
     std::cout << "\nOpções para algoritmo randomized:" << std::endl;
     std::cout << "  -alpha <valor>   Valor de alpha (ex: 0.1, 0.3, 0.5)" << std::endl;
     std::cout << "  -i <valor>       Número de iterações (padrão: 30)" << std::endl;
@@ -23,9 +28,34 @@ void printUsage(const char* programName) {
     std::cout << "  -alphas <v1,v2,v3>  Lista de alphas separados por vírgula (ex: 0.1,0.3,0.5)" << std::endl;
     std::cout << "  -i <valor>          Número de iterações (padrão: 300)" << std::endl;
     std::cout << "  -b <valor>          Tamanho do bloco (padrão: 30)" << std::endl;
+    std::cout << "  -elite <valor>      Pool elite com path relinking (ex: 10; padrão: 0 = desativado)" << std::endl;
+    std::cout << "\nFase de melhoria (após qualquer algoritmo):" << std::endl;
+    std::cout << "  -ls <tipo>          none | tabu (padrão: none)" << std::endl;
+    std::cout << "  -tabu-iter <valor>  Iterações da busca tabu (padrão: 100000; 0 = sem limite)" << std::endl;
+    std::cout << "  -tabu-time <seg>    Tempo máximo da busca tabu (padrão: sem limite)" << std::endl;
+    std::cout << "  -tabu-mem <MB>      Memória das tabelas da busca tabu (padrão: 1024; 0 = sem limite)" << std::endl;
+    std::cout << "\nOrçamento de tempo:" << std::endl;
+    std::cout << "  --time-limit <seg>  Interrompe laços GRASP, busca local e melhoria ao atingir o tempo" << std::endl;
+    std::cout << "                      e retorna a melhor solução encontrada (padrão: sem limite)" << std::endl;
+    std::cout << "  --trace <arquivo>   Grava o histórico de melhorias (tempo, iteração, maior cor) em CSV" << std::endl;
+    std::cout << "  -lb <on|off>        Para os laços ao atingir o limite inferior do span (padrão: on)" << std::endl;
+    std::cout << "\nModo em lote:" << std::endl;
+    std::cout << "  -batch <plano>   Executa um plano de experimentos (dispensa -f/-p/-q/-a);" << std::endl;
+    std::cout << "                   -t define o número de workers" << std::endl;
+    std::cout << "\nModo serviço:" << std::endl;
+    std::cout << "  -serve <destino> Atende requisições JSON (uma por linha) em stdio ou em um socket Unix;" << std::endl;
+    std::cout << "                   -t define o número de workers e --time-limit o tempo padrão por requisição" << std::endl;
+    std::cout << "  -registry <N>    Grafos mantidos em memória pelo serviço (padrão: 32)" << std::endl;
     std::cout << "\nOpções gerais:" << std::endl;
     std::cout << "  -s <seed>        Semente para randomização (padrão: baseada em tempo)" << std::endl;
+    std::cout << "  -t <threads>     Threads para as iterações GRASP (padrão: 1; 0 = todas)" << std::endl;
+    std::cout << "  -d2 <modo>       Vizinhança a distância 2: auto | explicit | implicit (padrão: auto)" << std::endl;
+    std::cout << "  -d2mem <MB>      Limite de memória para as listas de distância 2 (padrão: 2048; 0 = sem limite)" << std::endl;
+    std::cout << "  -order <ordem>   Renumeração dos vértices: none | rcm | bfs | degree (padrão: none)" << std::endl;
+    std::cout << "  -cache <arquivo> Cache binário do grafo (criado se ausente ou desatualizado)" << std::endl;
     std::cout << "  -o <arquivo>     Arquivo de saída para solução (padrão: não salva)" << std::endl;
+    std::cout << "  -changes <arq>   Após resolver, aplica as alterações do arquivo ao grafo, uma a uma," << std::endl;
+    std::cout << "                   reparando a solução a cada uma (e+ u v, e- u v, v+, v- u)" << std::endl;
     std::cout << "  -csv <arquivo>   Arquivo CSV para resultados (padrão: results/results.csv)" << std::endl;
     std::cout << "\nExemplos:" << std::endl;
     std::cout << "  " << programName << " -f instances/grafo.col -p 2 -q 1 -a greedy" << std::endl;
@@ -43,10 +73,29 @@ int main(int argc, char* argv[]) {
     std::vector<double> alphas = {0.1, 0.3, 0.5};
     int iterations = -1;
     int blockSize = 30;
+    int eliteSize = 0;
+    std::string initial = "none";
     unsigned int seed = 0;
     bool seedProvided = false;
+    int threads = 1;
+    std::size_t distance2LimitMB = 2048;
+    Distance2Mode distance2Mode = Distance2Mode::Auto;
+    VertexOrder vertexOrder = VertexOrder::None;
+    std::string cacheFile = "";
     std::string outputFile = "";
     std::string csvFile = "results/results.csv";
+    bool csvProvided = false;
+    std::string batchFile = "";
+    std::string improvement = "none";
+    long long tabuIterations = 100000;
+    double tabuTimeLimit = 0.0;
+    std::size_t tabuMemoryMB = 1024;
+    double timeLimit = 0.0;
+    std::string traceFile = "";
+    bool earlyStop = true;
+    std::string changesFile = "";
+    std::string serveTarget = "";
+    std::size_t registryCapacity = 32;
     
     // Parse argumentos
     for (int i = 1; i < argc; i++) {
@@ -81,15 +130,97 @@ int main(int argc, char* argv[]) {
         else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
             blockSize = std::stoi(argv[++i]);
         }
+        else if (strcmp(argv[i], "-elite") == 0 && i + 1 < argc) {
+            eliteSize = std::stoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-init") == 0 && i + 1 < argc) {
+            initial = argv[++i];
+        }
         else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
             seed = std::stoul(argv[++i]);
             seedProvided = true;
         }
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-d2") == 0 && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "explicit") {
+                distance2Mode = Distance2Mode::Explicit;
+            } else if (mode == "implicit") {
+                distance2Mode = Distance2Mode::Implicit;
+            } else if (mode == "auto") {
+                distance2Mode = Distance2Mode::Auto;
+            } else {
+                std::cerr << "Modo de distância 2 inválido: " << mode << std::endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-order") == 0 && i + 1 < argc) {
+            std::string order = argv[++i];
+            if (order == "none") {
+                vertexOrder = VertexOrder::None;
+            } else if (order == "rcm") {
+                vertexOrder = VertexOrder::RCM;
+            } else if (order == "bfs") {
+                vertexOrder = VertexOrder::BFS;
+            } else if (order == "degree") {
+                vertexOrder = VertexOrder::Degree;
+            } else {
+                std::cerr << "Ordem de vértices inválida: " << order << std::endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-d2mem") == 0 && i + 1 < argc) {
+            distance2LimitMB = std::stoul(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-cache") == 0 && i + 1 < argc) {
+            cacheFile = argv[++i];
+        }
         else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
             outputFile = argv[++i];
         }
         else if (strcmp(argv[i], "-csv") == 0 && i + 1 < argc) {
             csvFile = argv[++i];
+            csvProvided = true;
+        }
+        else if (strcmp(argv[i], "-ls") == 0 && i + 1 < argc) {
+            improvement = argv[++i];
+        }
+        else if (strcmp(argv[i], "-tabu-iter") == 0 && i + 1 < argc) {
+            tabuIterations = std::stoll(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-tabu-time") == 0 && i + 1 < argc) {
+            tabuTimeLimit = std::stod(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-tabu-mem") == 0 && i + 1 < argc) {
+            tabuMemoryMB = std::stoul(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) {
+            timeLimit = std::stod(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "-lb") == 0 && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (value != "on" && value != "off") {
+                std::cerr << "Valor inválido para -lb: " << value << " (use on ou off)" << std::endl;
+                return 1;
+            }
+            earlyStop = value == "on";
+        }
+        else if (strcmp(argv[i], "-changes") == 0 && i + 1 < argc) {
+            changesFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "-batch") == 0 && i + 1 < argc) {
+            batchFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "-serve") == 0 && i + 1 < argc) {
+            serveTarget = argv[++i];
+        }
+        else if (strcmp(argv[i], "-registry") == 0 && i + 1 < argc) {
+            registryCapacity = std::stoul(argv[++i]);
         }
         else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             printUsage(argv[0]);
@@ -97,6 +228,47 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (threads <= 0) {
+        threads = ThreadPool::hardwareThreads();
+    }
+    
+    GraphOptions graphOptions;
+    graphOptions.numThreads = threads;
+    graphOptions.distance2MemoryLimit = distance2LimitMB << 20;
+    graphOptions.distance2Mode = distance2Mode;
+    graphOptions.vertexOrder = vertexOrder;
+    graphOptions.cacheFile = cacheFile;
+    
+    // Modo serviço: grafos lidos uma vez e mantidos entre requisições
+    if (!serveTarget.empty()) {
+        ServiceOptions serviceOptions;
+        serviceOptions.socketPath = serveTarget == "stdio" ? "" : serveTarget;
+        serviceOptions.workers = threads;
+        serviceOptions.registryCapacity = registryCapacity;
+        serviceOptions.timeLimit = timeLimit;
+        serviceOptions.graphOptions = graphOptions;
+        SolverService service(serviceOptions);
+        return service.run();
+    }
+    
+    // Modo em lote: cada instância é lida uma vez para toda a grade
+    if (!batchFile.empty()) {
+        ExperimentPlan plan;
+        if (!Experiment::readPlan(batchFile, plan)) {
+            return 1;
+        }
+        if (csvProvided) {
+            plan.csvFile = csvFile;
+        }
+        if (timeLimit > 0) {
+            plan.timeLimit = timeLimit;
+        }
+        if (!earlyStop) {
+            plan.earlyStop = false;
+        }
+        return Experiment::runPlan(plan, threads, graphOptions);
+    }
+    
     // Validação de parâmetros obrigatórios
     if (filename.empty() || p < 0 || q < 0 || algorithm.empty()) {
         std::cerr << "Erro: Parâmetros obrigatórios faltando!" << std::endl;
@@ -113,6 +285,24 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (!Experiment::isKnownAlgorithm(algorithm)) {
+        std::cerr << "Algoritmo inválido: " << algorithm << std::endl;
+        std::cerr << "Use: greedy, dsatur, randomized, reactive ou exact" << std::endl;
+        return 1;
+    }
+    
+    if (!Experiment::isKnownInitial(initial)) {
+        std::cerr << "Solução inicial inválida: " << initial << std::endl;
+        std::cerr << "Use: none ou dsatur" << std::endl;
+        return 1;
+    }
+    
+    if (!Experiment::isKnownImprovement(improvement)) {
+        std::cerr << "Busca local inválida: " << improvement << std::endl;
+        std::cerr << "Use: none ou tabu" << std::endl;
+        return 1;
+    }
+    
     // Gera semente se não fornecida
     if (!seedProvided) {
         seed = Utils::generateSeed();
@@ -123,34 +313,61 @@ int main(int argc, char* argv[]) {
     std::cout << "p = " << p << ", q = " << q << std::endl;
     std::cout << "Algoritmo: " << algorithm << std::endl;
     std::cout << "Semente: " << seed << std::endl;
+    std::cout << "Threads: " << threads << std::endl;
+    
+    // CSV com colunas de outra versão: falha antes de executar
+    if (!Utils::createCSVHeaderIfNeeded(csvFile)) {
+        return 1;
+    }
     
     // Lê o grafo
-    Graph* graph = Graph::readFromFile(filename);
+    Graph* graph = Graph::readFromFile(filename, graphOptions);
     if (graph == nullptr) {
         std::cerr << "Erro ao ler o grafo!" << std::endl;
         return 1;
     }
     
-    // Cria solver
-    LPQColoring solver(graph, p, q, seed);
+    ExperimentConfig config;
+    config.algorithm = algorithm;
+    config.p = p;
+    config.q = q;
+    config.alpha = alpha;
+    config.alphas = alphas;
+    config.iterations = iterations;
+    config.blockSize = blockSize;
+    config.eliteSize = eliteSize;
+    config.initial = initial;
+    config.seed = seed;
+    config.threads = threads;
+    config.improvement = improvement;
+    config.tabuIterations = tabuIterations;
+    config.tabuTimeLimit = tabuTimeLimit;
+    config.tabuMemoryLimit = tabuMemoryMB << 20;
+    config.timeLimit = timeLimit;
+    config.traceFile = traceFile;
+    config.earlyStop = earlyStop;
     
-    // Executa algoritmo
-    Solution solution;
-    double executionTime = 0.0;
+    // Limite inferior do span, usado para parar as iterações no ótimo
+    auto lowerBound = LowerBound::compute(graph, p, q);
+    config.lowerBound = lowerBound.value;
+    std::cout << "Limite inferior: " << lowerBound.value << " (Δ = " << lowerBound.maxDegree
+              << ": " << lowerBound.degreeBound << "; clique em G de " << lowerBound.cliqueSize
+              << ": " << lowerBound.cliqueBound << "; clique em G² de " << lowerBound.squareCliqueSize
+              << ": " << lowerBound.squareCliqueBound << ")" << std::endl;
     
     if (algorithm == "greedy") {
         std::cout << "\nExecutando algoritmo guloso..." << std::endl;
-        executionTime = Utils::measureExecutionTime([&]() {
-            solution = solver.greedy();
-        });
+    }
+    else if (algorithm == "dsatur") {
+        std::cout << "\nExecutando DSATUR..." << std::endl;
+    }
+    else if (algorithm == "exact") {
+        std::cout << "\nExecutando branch-and-bound exato..." << std::endl;
     }
     else if (algorithm == "randomized") {
         std::cout << "\nExecutando algoritmo guloso randomizado..." << std::endl;
         std::cout << "Alpha = " << alpha << std::endl;
         std::cout << "Iterações = " << iterations << std::endl;
-        executionTime = Utils::measureExecutionTime([&]() {
-            solution = solver.greedyRandomized(alpha, iterations);
-        });
     }
     else if (algorithm == "reactive") {
         std::cout << "\nExecutando algoritmo guloso randomizado reativo..." << std::endl;
@@ -162,26 +379,73 @@ int main(int argc, char* argv[]) {
         std::cout << std::endl;
         std::cout << "Iterações = " << iterations << std::endl;
         std::cout << "Tamanho do bloco = " << blockSize << std::endl;
-        executionTime = Utils::measureExecutionTime([&]() {
-            solution = solver.greedyRandomizedReactive(alphas, iterations, blockSize);
-        });
+        std::cout << "Pool elite = " << eliteSize << (eliteSize > 0 ? "" : " (sem path relinking)") << std::endl;
     }
-    else {
-        std::cerr << "Algoritmo inválido: " << algorithm << std::endl;
-        std::cerr << "Use: greedy, randomized ou reactive" << std::endl;
-        delete graph;
-        return 1;
+    if (initial != "none" && (algorithm == "randomized" || algorithm == "reactive")) {
+        std::cout << "Solução inicial: " << initial << std::endl;
     }
     
-    // Verifica validade da solução
-    std::cout << "\nVerificando validade da solução..." << std::endl;
-    bool valid = solver.isSolutionValid(solution);
+    if (improvement == "tabu") {
+        std::cout << "Fase de melhoria: busca tabu (iterações = " << tabuIterations << ")" << std::endl;
+    }
+    
+    // Executa algoritmo e verifica validade da solução
+    Solution solution;
+    bool valid = false;
+    ExecutionResult result = Experiment::run(graph, filename, config, solution, valid);
     
     // Resultados
     std::cout << "\n=== Resultados ===" << std::endl;
-    std::cout << "Tempo de execução: " << executionTime << " segundos" << std::endl;
+    std::cout << "Tempo de execução: " << result.executionTime << " segundos" << std::endl;
     std::cout << "Maior cor utilizada: " << solution.maxColor << std::endl;
     std::cout << "Solução válida: " << (valid ? "SIM" : "NÃO") << std::endl;
+    if (solution.maxColor <= result.lowerBound) {
+        std::cout << "Ótimo comprovado (igual ao limite inferior)" << std::endl;
+    } else {
+        std::cout << "Gap para o limite inferior: " << result.gap * 100 << "%" << std::endl;
+    }
+    if (algorithm == "exact" && result.lowerBound > lowerBound.value) {
+        std::cout << "Limite inferior comprovado pela busca: " << result.lowerBound << std::endl;
+    }
+    
+    // Grafo dinâmico: cada alteração é aplicada e reparada isoladamente
+    if (!changesFile.empty()) {
+        std::vector<GraphChange> changes;
+        if (graph->isReordered()) {
+            std::cerr << "Erro: -changes usa os IDs do arquivo e não pode ser combinado com -order" << std::endl;
+        } else if (Utils::readGraphChanges(changesFile, changes)) {
+            LPQColoring solver(graph, p, q, seed);
+            solver.setNumThreads(threads);
+            RepairReport total;
+            std::size_t applied = 0;
+            double totalTime = 0.0, worstTime = 0.0;
+            for (const auto& change : changes) {
+                auto elapsed = Utils::measureExecutionTime([&]() {
+                    if (!graph->applyChange(change)) return;
+                    applied++;
+                    auto report = solver.repair(solution, std::vector<GraphChange>(1, change));
+                    total.checked += report.checked;
+                    total.recolored += report.recolored;
+                    total.improved += report.improved;
+                });
+                totalTime += elapsed;
+                worstTime = std::max(worstTime, elapsed);
+            }
+            
+            std::cout << "\n=== Alterações do grafo ===" << std::endl;
+            std::cout << "Alterações aplicadas: " << applied << " de " << changes.size() << " ("
+                      << graph->getNumVertices() << " vértices)" << std::endl;
+            std::cout << "Vértices recoloridos: " << total.recolored << ", melhorados: " << total.improved
+                      << std::endl;
+            if (!changes.empty()) {
+                std::cout << "Tempo por alteração: médio " << totalTime / changes.size() * 1e6
+                          << " us, máximo " << worstTime * 1e6 << " us" << std::endl;
+            }
+            std::cout << "Maior cor após as alterações: " << solution.maxColor << std::endl;
+            std::cout << "Solução válida após as alterações: "
+                      << (solver.isSolutionValid(solution) ? "SIM" : "NÃO") << std::endl;
+        }
+    }
     
     // Salva solução em arquivo se especificado
     if (!outputFile.empty()) {
@@ -189,41 +453,13 @@ int main(int argc, char* argv[]) {
     }
     
     // Salva resultados em CSV
-    ExecutionResult result;
-    result.datetime = Utils::getCurrentDateTime();
-    result.instance = filename;
-    result.p = p;
-    result.q = q;
-    result.algorithm = algorithm;
-    
-    // Preenche coluna alpha apropriadamente para cada algoritmo
-    if (algorithm == "randomized") {
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(2) << alpha;
-        result.alpha = oss.str();
-    } else if (algorithm == "reactive") {
-        // Para reactive, mostra todos os alphas usados
-        std::ostringstream oss;
-        for (size_t i = 0; i < alphas.size(); i++) {
-            oss << std::fixed << std::setprecision(2) << alphas[i];
-            if (i < alphas.size() - 1) oss << ";";
-        }
-        result.alpha = oss.str();
-    } else {
-        result.alpha = "N/A";
+    if (Utils::saveResultToCSV(result, csvFile)) {
+        std::cout << "\nResultados salvos em: " << csvFile << std::endl;
+    }
+    if (Instrumentation::enabled()) {
+        std::cout << "Instrumentação: " << result.instrumentation << std::endl;
+        std::cout << "Instrumentação salva em: " << Utils::instrumentationFile(csvFile) << std::endl;
     }
-    
-    result.iterations = iterations;
-    result.blockSize = (algorithm == "reactive") ? blockSize : 0;
-    result.seed = seed;
-    result.executionTime = executionTime;
-    result.bestSolution = solution.maxColor;
-    result.avgSolution = solution.maxColor;  // Para uma única execução, avg = best
-    result.bestAlpha = (algorithm == "randomized") ? alpha : 
-                       (algorithm == "reactive" && !alphas.empty()) ? alphas[0] : 0.0;
-    
-    Utils::saveResultToCSV(result, csvFile);
-    std::cout << "\nResultados salvos em: " << csvFile << std::endl;
     
     // Cleanup
     delete graph;
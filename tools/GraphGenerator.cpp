@@ -0,0 +1,122 @@
+// Gerador de instâncias sintéticas para estudos de escala (bin/lpqgen).
+// As arestas são produzidas em fluxo e gravadas diretamente no arquivo, em
+// DIMACS ou no formato binário lido por lpqcoloring -f, sem manter a lista
+// de arestas em memória.
+//
+// Uso: bin/lpqgen -type <família> -n <vértices> [-d grau] [-s semente]
+//                 [-gamma expoente] [-format dimacs|binary] [-mem MB] -o <arquivo>
+
+#include "../include/Generator.h"
+#include "../include/Graph.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+void printUsage(const char* programName) {
+    std::cout << "\n=== Gerador de instâncias L(p,q) ===" << std::endl;
+    std::cout << "\nUso: " << programName << " <opcoes>" << std::endl;
+    std::cout << "\nOpções:" << std::endl;
+    std::cout << "  -type <família>   random | geometric | grid | hex | powerlaw" << std::endl;
+    std::cout << "  -n <vértices>     Número de vértices" << std::endl;
+    std::cout << "  -d <grau>         Grau médio (padrão: 16; ignorado em grid e hex)" << std::endl;
+    std::cout << "  -s <seed>         Semente (padrão: 1)" << std::endl;
+    std::cout << "  -gamma <valor>    Expoente da lei de potência, > 2 (padrão: 2.5)" << std::endl;
+    std::cout << "  -format <formato> dimacs | binary (padrão: dimacs)" << std::endl;
+    std::cout << "  -mem <MB>         Memória para as listas no formato binário; acima disso o" << std::endl;
+    std::cout << "                    grafo é regerado por faixas de vértices (padrão: 1024)" << std::endl;
+    std::cout << "  -o <arquivo>      Arquivo de saída" << std::endl;
+    std::cout << "\nExemplos:" << std::endl;
+    std::cout << "  " << programName << " -type geometric -n 1000000 -d 16 -o instances/udg_1m.col" << std::endl;
+    std::cout << "  " << programName << " -type hex -n 10000000 -format binary -o instances/hex_10m.bin" << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string type = "";
+    long long n = 0;
+    double degree = 16.0;
+    unsigned int seed = 1;
+    double gamma = 2.5;
+    std::string format = "dimacs";
+    std::string outputFile = "";
+    std::size_t memoryLimit = std::size_t(1024) << 20;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-type") == 0 && i + 1 < argc) {
+            type = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            n = std::stoll(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            degree = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (strcmp(argv[i], "-gamma") == 0 && i + 1 < argc) {
+            gamma = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "-format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "-mem") == 0 && i + 1 < argc) {
+            memoryLimit = static_cast<std::size_t>(std::max(1L, std::stol(argv[++i]))) << 20;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    GraphFamily family;
+    if (!Generator::parseFamily(type, family)) {
+        std::cerr << "Erro: família inválida ou ausente (-type)" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (n < 1 || n > 2147483647LL) {
+        std::cerr << "Erro: -n deve estar entre 1 e 2147483647" << std::endl;
+        return 1;
+    }
+    if (format != "dimacs" && format != "binary") {
+        std::cerr << "Erro: formato inválido: " << format << " (use dimacs ou binary)" << std::endl;
+        return 1;
+    }
+    if (outputFile.empty()) {
+        std::cerr << "Erro: arquivo de saída é obrigatório (-o)" << std::endl;
+        return 1;
+    }
+    
+    auto stream = Generator::stream(family, static_cast<int>(n), degree, seed, gamma);
+    if (!stream) {
+        std::cerr << "Erro: parâmetros inválidos (grau médio > 0; -gamma > 2 em powerlaw)" << std::endl;
+        return 1;
+    }
+    
+    std::ostringstream description;
+    description << "lpqgen -type " << Generator::familyName(family) << " -n " << n;
+    if (family != GraphFamily::Grid && family != GraphFamily::Hexagonal) {
+        description << " -d " << degree << " -s " << seed;
+    }
+    if (family == GraphFamily::PowerLaw) description << " -gamma " << gamma;
+    
+    std::cout << "Gerando: " << description.str() << std::endl;
+    
+    long long edges = -1;
+    auto seconds = Utils::measureExecutionTime([&]() {
+        edges = format == "binary" ? Graph::writeBinary(*stream, outputFile, memoryLimit)
+                                   : Generator::writeDimacs(*stream, outputFile, description.str());
+    });
+    if (edges < 0) return 1;
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << n << " vértices, " << edges << " arestas (grau médio " << (2.0 * edges / n) << ")"
+              << std::endl;
+    std::cout << "Arquivo " << format << " gravado em: " << outputFile << " ("
+              << std::setprecision(3) << seconds << " s)" << std::endl;
+    return 0;
+}